@@ -0,0 +1,147 @@
+#pragma once
+#include "geometry.hpp"
+#include "memory_tracking.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <ranges>
+#include <vector>
+
+namespace geometry::bench {
+
+/*
+ * Распределения входных точек для бенчмарков
+ */
+enum class Distribution { Uniform, Clustered, Collinear, CoCircular };
+
+// Размеры входа: 10^2 .. 10^7
+inline constexpr int64_t kMinSize = 100;
+inline constexpr int64_t kMaxSize = 10'000'000;
+
+// Ограничение для алгоритмов с квадратичной сложностью
+inline constexpr int64_t kMaxQuadraticSize = 10'000;
+
+inline std::vector<Point2D> GeneratePoints(Distribution distribution, size_t count, uint32_t seed = 20) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coord_dist(-1000.0, 1000.0);
+
+    std::vector<Point2D> points;
+    points.reserve(count);
+
+    switch (distribution) {
+    case Distribution::Uniform: {
+        for (size_t i = 0; i != count; ++i) {
+            points.emplace_back(coord_dist(gen), coord_dist(gen));
+        }
+        break;
+    }
+    case Distribution::Clustered: {
+        // ~sqrt(n) кластеров с нормальным распределением точек вокруг центров
+        const size_t clusters = std::max<size_t>(1, static_cast<size_t>(std::sqrt(count)));
+        std::vector<Point2D> centers;
+        centers.reserve(clusters);
+        for (size_t i = 0; i != clusters; ++i) {
+            centers.emplace_back(coord_dist(gen), coord_dist(gen));
+        }
+
+        std::uniform_int_distribution<size_t> cluster_dist(0, clusters - 1);
+        std::normal_distribution<double> offset_dist(0.0, 10.0);
+        for (size_t i = 0; i != count; ++i) {
+            const auto &c = centers[cluster_dist(gen)];
+            points.emplace_back(c.x + offset_dist(gen), c.y + offset_dist(gen));
+        }
+        break;
+    }
+    case Distribution::Collinear: {
+        // большая часть точек лежит на нескольких прямых
+        constexpr size_t lines = 8;
+        std::uniform_real_distribution<double> t_dist(0.0, 1.0);
+        std::uniform_int_distribution<size_t> line_dist(0, lines - 1);
+        std::vector<std::pair<Point2D, Point2D>> segments;
+        for (size_t i = 0; i != lines; ++i) {
+            segments.emplace_back(Point2D{coord_dist(gen), coord_dist(gen)}, Point2D{coord_dist(gen), coord_dist(gen)});
+        }
+        for (size_t i = 0; i != count; ++i) {
+            if (i % 10 == 0) {
+                points.emplace_back(coord_dist(gen), coord_dist(gen));
+                continue;
+            }
+            const auto &[a, b] = segments[line_dist(gen)];
+            points.push_back(a + (b - a) * t_dist(gen));
+        }
+        break;
+    }
+    case Distribution::CoCircular: {
+        std::uniform_real_distribution<double> angle_dist(0.0, 2.0 * std::numbers::pi);
+        for (size_t i = 0; i != count; ++i) {
+            const double angle = angle_dist(gen);
+            points.emplace_back(1000.0 * std::cos(angle), 1000.0 * std::sin(angle));
+        }
+        break;
+    }
+    }
+    return points;
+}
+
+// Фигуры всех типов с центрами из заданного распределения
+inline std::vector<Shape> GenerateShapes(Distribution distribution, size_t count, uint32_t seed = 20) {
+    const auto centers = GeneratePoints(distribution, count, seed);
+
+    std::mt19937 gen(seed + 1);
+    std::uniform_real_distribution<double> size_dist(1.0, 20.0);
+    std::uniform_int_distribution<int> sides_dist(3, 12);
+
+    std::vector<Shape> shapes;
+    shapes.reserve(count);
+    for (const auto &[index, center] : std::views::enumerate(centers)) {
+        const double size = size_dist(gen);
+        switch (index % 6) {
+        case 0:
+            shapes.emplace_back(Line{center, {center.x + size, center.y + size}});
+            break;
+        case 1:
+            shapes.emplace_back(Triangle{center, {center.x + size, center.y}, {center.x + size / 2, center.y + size}});
+            break;
+        case 2:
+            shapes.emplace_back(Rectangle{center, size, size * 0.8});
+            break;
+        case 3:
+            shapes.emplace_back(RegularPolygon{center, size, sides_dist(gen)});
+            break;
+        case 4:
+            shapes.emplace_back(Circle{center, size});
+            break;
+        default:
+            shapes.emplace_back(Polygon{RegularPolygon{center, size, sides_dist(gen)}.Vertices()});
+            break;
+        }
+    }
+    return shapes;
+}
+
+// Счётчик пропускной способности: элементов в секунду
+inline benchmark::Counter Throughput(double items) {
+    return benchmark::Counter(items, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/*
+ * Выполняет f один раз вне замера и сравнивает число аллокаций с бюджетом
+ *
+ * Результат попадает в счётчик allocs/iter; при превышении бюджета бенчмарк завершается с ошибкой
+ */
+template <typename F>
+bool CheckAllocationBudget(benchmark::State &state, uint64_t budget, F &&f) {
+    memory::ScopedAllocationCounter counter;
+    f();
+    const auto allocations = counter.Allocations();
+
+    state.counters["allocs/iter"] = static_cast<double>(allocations);
+    if (memory::GlobalHooksInstalled() && allocations > budget) {
+        state.SkipWithError("allocation budget exceeded");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace geometry::bench
@@ -0,0 +1,57 @@
+#include "bench_utils.hpp"
+#include "bounding_volumes.hpp"
+#include "shape_utils.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_MinEnclosingCircle(benchmark::State &state, Distribution distribution) {
+    const auto points = GeneratePoints(distribution, state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(queries::MinEnclosingCircle(points));
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_MinEnclosingCircle, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_MinEnclosingCircle, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+
+// candidates -- доля пар, дошедших до точной проверки; сравнивается с BM_FindAllCollisions
+static void BM_FindAllCollisionsTightest(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+
+    size_t candidates = 0;
+    for (auto _ : state) {
+        auto collisions = utils::FindAllCollisions(shapes, queries::BoundingVolume::Tightest);
+        candidates = collisions.size();
+        benchmark::DoNotOptimize(collisions);
+    }
+
+    const double pairs = static_cast<double>(shapes.size()) * static_cast<double>(shapes.size() - 1) / 2.0;
+    state.counters["pairs/s"] = Throughput(pairs);
+    state.counters["candidates"] = static_cast<double>(candidates) / pairs;
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_FindAllCollisionsTightest, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK_CAPTURE(BM_FindAllCollisionsTightest, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
@@ -0,0 +1,51 @@
+#include "bench_utils.hpp"
+#include "closest_pair.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_ClosestPair(benchmark::State &state, Distribution distribution) {
+    const auto points = GeneratePoints(distribution, state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(spatial::ClosestPair(points));
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_ClosestPair, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_ClosestPair, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+static void BM_AllNearestNeighbours(benchmark::State &state, Distribution distribution) {
+    const auto points = GeneratePoints(distribution, state.range(0));
+
+    for (auto _ : state) {
+        auto neighbours = spatial::AllNearestNeighbours(points);
+        benchmark::DoNotOptimize(neighbours);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_AllNearestNeighbours, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_AllNearestNeighbours, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
@@ -0,0 +1,62 @@
+#include "bench_utils.hpp"
+#include "convex_hull.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_GrahamScan(benchmark::State &state, Distribution distribution) {
+    const auto points = GeneratePoints(distribution, state.range(0));
+
+    for (auto _ : state) {
+        auto hull = convex_hull::GrahamScan(points);
+        benchmark::DoNotOptimize(hull);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_GrahamScan, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_GrahamScan, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_GrahamScan, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_GrahamScan, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+static void BM_ConvexHullOfShapes(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+
+    for (auto _ : state) {
+        auto hull = convex_hull::ConvexHullOfShapes(shapes);
+        benchmark::DoNotOptimize(hull);
+    }
+
+    state.counters["shapes/s"] = Throughput(shapes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_ConvexHullOfShapes, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_ConvexHullOfShapes, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
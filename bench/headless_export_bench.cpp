@@ -0,0 +1,60 @@
+#include "bench_utils.hpp"
+#include "headless_export.hpp"
+#include <benchmark/benchmark.h>
+#include <ostream>
+#include <streambuf>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+namespace {
+
+// поток, отбрасывающий данные: замеряется только подготовка и форматирование
+class NullBuffer : public std::streambuf {
+protected:
+    std::streamsize xsputn(const char *, std::streamsize count) override { return count; }
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+};
+
+}  // namespace
+
+static void BM_WriteSvg(benchmark::State &state) {
+    const auto shapes = GenerateShapes(Distribution::Uniform, state.range(0));
+    NullBuffer buffer;
+    std::ostream out{&buffer};
+
+    for (auto _ : state) {
+        visualization::WriteSvg(out, shapes);
+    }
+
+    state.counters["shapes/s"] = Throughput(shapes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_Rasterize(benchmark::State &state, bool fill) {
+    const auto shapes = GenerateShapes(Distribution::Uniform, state.range(0));
+
+    for (auto _ : state) {
+        auto image = visualization::Rasterize(shapes, {.fill = fill});
+        benchmark::DoNotOptimize(image);
+    }
+
+    state.counters["shapes/s"] = Throughput(shapes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_WriteSvg)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_Rasterize, outline, false)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_Rasterize, fill, true)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,45 @@
+#include "bench_utils.hpp"
+#include "incremental_delaunay.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_IncrementalDelaunayBuild(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+
+    for (auto _ : state) {
+        triangulation::IncrementalDelaunay dt{points};
+        benchmark::DoNotOptimize(dt.TrianglesCount());
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_IncrementalDelaunayBuild)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+// одна итерация -- вставка и удаление точки в триангуляции из range(0) точек
+static void BM_IncrementalDelaunayUpdate(benchmark::State &state) {
+    triangulation::IncrementalDelaunay dt{GeneratePoints(Distribution::Uniform, state.range(0))};
+    const auto updates = GeneratePoints(Distribution::Uniform, 4096, 21);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto id = dt.Insert(updates[i++ % updates.size()]);
+        benchmark::DoNotOptimize(dt.Remove(id));
+    }
+
+    state.counters["updates/s"] = Throughput(1);
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_IncrementalDelaunayUpdate)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oLogN);
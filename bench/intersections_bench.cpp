@@ -0,0 +1,59 @@
+#include "bench_utils.hpp"
+#include "intersections.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// Пары соседних отрезков и окружностей: Line/Line, Line/Circle, Circle/Circle
+static std::vector<Shape> MakeLinesAndCircles(std::span<const Point2D> points) {
+    std::vector<Shape> shapes;
+    shapes.reserve(points.size());
+    for (size_t i = 0; i != points.size(); ++i) {
+        const auto &p = points[i];
+        if (i % 2 == 0) {
+            shapes.emplace_back(Line{p, points[(i + 1) % points.size()]});
+        } else {
+            shapes.emplace_back(Circle{p, 25.0});
+        }
+    }
+    return shapes;
+}
+
+static void BM_IntersectionVisitor(benchmark::State &state, Distribution distribution) {
+    // const важен: для неконстантных альтернатив visitor выбирает перегрузку (auto &&, auto &&)
+    const auto shapes = MakeLinesAndCircles(GeneratePoints(distribution, state.range(0)));
+
+    for (auto _ : state) {
+        size_t found = 0;
+        for (size_t i = 1; i < shapes.size(); ++i) {
+            const auto result = std::visit(intersections::IntersectionVisitor{}, shapes[i - 1], shapes[i]);
+            found += !std::holds_alternative<std::monostate>(result);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.counters["pairs/s"] = Throughput(shapes.size() - 1);
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_IntersectionVisitor, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_IntersectionVisitor, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_IntersectionVisitor, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_IntersectionVisitor, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,76 @@
+#include "bench_utils.hpp"
+#include "kd_tree.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_KdTreeBuild(benchmark::State &state, Distribution distribution) {
+    const auto points = GeneratePoints(distribution, state.range(0));
+
+    for (auto _ : state) {
+        spatial::KdTree tree{points};
+        benchmark::DoNotOptimize(tree);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_KdTreeBuild, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_KdTreeBuild, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+// 10^5 запросов по 8 соседей к дереву из range(0) точек
+static void BM_KdTreeKNearest(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+    const auto queries = GeneratePoints(Distribution::Uniform, 100'000, 21);
+    const spatial::KdTree tree{points};
+
+    for (auto _ : state) {
+        auto neighbours = tree.KNearest(queries, 8);
+        benchmark::DoNotOptimize(neighbours);
+    }
+
+    state.counters["queries/s"] = Throughput(queries.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_KdTreeKNearest)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oLogN);
+
+// 10^5 квадратов со стороной 20 (около 10^-4 площади)
+static void BM_KdTreeRangeCount(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+    const auto centers = GeneratePoints(Distribution::Uniform, 100'000, 21);
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(centers.size());
+    for (const auto &c : centers) {
+        boxes.push_back({c.x - 10, c.y - 10, c.x + 10, c.y + 10});
+    }
+    const spatial::KdTree tree{points};
+
+    for (auto _ : state) {
+        auto counts = tree.RangeCount(boxes);
+        benchmark::DoNotOptimize(counts);
+    }
+
+    state.counters["queries/s"] = Throughput(boxes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_KdTreeRangeCount)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oLogN);
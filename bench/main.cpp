@@ -0,0 +1,26 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char **argv) {
+    std::vector<char *> args(argv, argv + argc);
+
+    // По умолчанию выводим результаты в JSON, чтобы сравнивать их между релизами
+    const bool has_format = std::ranges::any_of(args, [](std::string_view arg) {
+        return arg.starts_with("--benchmark_format");
+    });
+    static char json_format[] = "--benchmark_format=json";
+    if (!has_format) {
+        args.push_back(json_format);
+    }
+
+    int args_count = static_cast<int>(args.size());
+    ::benchmark::Initialize(&args_count, args.data());
+    if (::benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "bench_utils.hpp"
+#include "narrow_phase.hpp"
+#include "queries.hpp"
+#include "shape_utils.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// overlaps -- доля кандидатов широкой фазы по прямоугольникам, которые действительно пересекаются
+static void BM_NarrowPhaseFilter(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+    std::vector<intersections::ShapePair> candidates;
+    for (uint32_t i = 0; i != shapes.size(); ++i) {
+        for (uint32_t j = i + 1; j != shapes.size(); ++j) {
+            if (queries::BoundingBoxesOverlap(shapes[i], shapes[j])) {
+                candidates.emplace_back(i, j);
+            }
+        }
+    }
+
+    size_t overlaps = 0;
+    for (auto _ : state) {
+        const intersections::NarrowPhase narrow_phase{shapes};
+        auto res = narrow_phase.Filter(candidates);
+        overlaps = res.size();
+        benchmark::DoNotOptimize(res);
+    }
+
+    state.counters["candidates/s"] = Throughput(candidates.size());
+    state.counters["overlaps"] = static_cast<double>(overlaps) / static_cast<double>(candidates.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_NarrowPhaseFilter, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK_CAPTURE(BM_NarrowPhaseFilter, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+
+// сравнивается с BM_FindAllCollisions и BM_FindAllCollisionsTightest
+static void BM_FindAllOverlaps(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+
+    for (auto _ : state) {
+        auto overlaps = utils::FindAllOverlaps(shapes);
+        benchmark::DoNotOptimize(overlaps);
+    }
+
+    const double pairs = static_cast<double>(shapes.size()) * static_cast<double>(shapes.size() - 1) / 2.0;
+    state.counters["pairs/s"] = Throughput(pairs);
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_FindAllOverlaps, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK_CAPTURE(BM_FindAllOverlaps, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
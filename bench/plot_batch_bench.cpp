@@ -0,0 +1,34 @@
+#include "bench_utils.hpp"
+#include "plot_batch.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_BuildShapeBatches(benchmark::State &state, bool level_of_detail) {
+    const auto shapes = GenerateShapes(Distribution::Uniform, state.range(0));
+
+    visualization::BatchOptions options;
+    if (level_of_detail) {
+        options.pixel_size = visualization::PixelSize(visualization::SceneBoundBox(shapes), 900);
+    }
+
+    for (auto _ : state) {
+        auto batches = visualization::BuildShapeBatches(shapes, options);
+        benchmark::DoNotOptimize(batches);
+    }
+
+    state.counters["shapes/s"] = Throughput(shapes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_BuildShapeBatches, full_detail, false)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_BuildShapeBatches, level_of_detail, true)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
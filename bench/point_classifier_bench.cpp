@@ -0,0 +1,35 @@
+#include "bench_utils.hpp"
+#include "point_classifier.hpp"
+#include "voronoi.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+using namespace geometry::queries;
+
+// регионы -- ячейки Вороного тысячи сайтов, range(0) точек того же распределения
+static void BM_RegionClassifier(benchmark::State &state) {
+    const auto sites = GeneratePoints(Distribution::Uniform, 1000, 21);
+    BoundingBox box = Polygon{sites}.BoundBox();
+    const auto diagram = voronoi::FortuneVoronoi(sites, box).value();
+    std::vector<Polygon> regions;
+    for (size_t i = 0; i != diagram.CellsCount(); ++i) {
+        regions.push_back(diagram.CellPolygon(i));
+    }
+    const RegionClassifier classifier{regions};
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+
+    for (auto _ : state) {
+        auto ids = classifier.Classify(points);
+        benchmark::DoNotOptimize(ids);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RegionClassifier)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
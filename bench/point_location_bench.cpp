@@ -0,0 +1,57 @@
+#include "bench_utils.hpp"
+#include "point_location.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+namespace {
+
+// триангуляция квадратичная, поэтому сетка строится один раз на kMaxQuadraticSize точках
+const triangulation::DelaunayMesh &BenchMesh() {
+    static const auto mesh =
+        triangulation::DelaunayTriangulationMesh(GeneratePoints(Distribution::Uniform, kMaxQuadraticSize)).value();
+    return mesh;
+}
+
+}  // namespace
+
+static void BM_PointLocatorBatch(benchmark::State &state) {
+    const triangulation::PointLocator locator{BenchMesh()};
+    const auto queries = GeneratePoints(Distribution::Uniform, state.range(0), 21);
+
+    for (auto _ : state) {
+        auto found = locator.Locate(queries);
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.counters["queries/s"] = Throughput(queries.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_PointLocatorBatch)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+// без сортировки: каждый запрос начинается с ближайшей опорной вершины
+static void BM_PointLocatorSingle(benchmark::State &state) {
+    const triangulation::PointLocator locator{BenchMesh()};
+    const auto queries = GeneratePoints(Distribution::Uniform, state.range(0), 21);
+
+    for (auto _ : state) {
+        for (const auto &q : queries) {
+            benchmark::DoNotOptimize(locator.Locate(q));
+        }
+    }
+
+    state.counters["queries/s"] = Throughput(queries.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_PointLocatorSingle)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 100)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,48 @@
+#include "bench_utils.hpp"
+#include "polygon_soa.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// один многоугольник из range(0) вершин
+static void BM_PolygonSoAMetrics(benchmark::State &state) {
+    const PolygonSoA polygon{GeneratePoints(Distribution::CoCircular, state.range(0))};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(polygon.Metrics());
+    }
+
+    state.counters["vertices/s"] = Throughput(polygon.Size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_PolygonSoAMetrics)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oN);
+
+// range(0) многоугольников по 16 вершин
+static void BM_PolygonSoAMetricsBatch(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, 16 * state.range(0));
+    std::vector<PolygonSoA> polygons;
+    polygons.reserve(state.range(0));
+    for (size_t i = 0; i != points.size(); i += 16) {
+        polygons.emplace_back(std::span{points}.subspan(i, 16));
+    }
+
+    for (auto _ : state) {
+        auto metrics = Metrics(polygons);
+        benchmark::DoNotOptimize(metrics);
+    }
+
+    state.counters["polygons/s"] = Throughput(polygons.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_PolygonSoAMetricsBatch)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,88 @@
+#include "bench_utils.hpp"
+#include "queries.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static void BM_DistanceToPoint(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+    const Point2D point{10.0, 10.0};
+
+    auto distances_sum = [&] {
+        double sum = 0.0;
+        for (const auto &shape : shapes) {
+            sum += queries::DistanceToPoint(shape, point);
+        }
+        return sum;
+    };
+
+    // для уже построенных фигур расстояние считается без обращений к куче
+    if (!CheckAllocationBudget(state, 0, distances_sum)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(distances_sum());
+    }
+
+    state.counters["shapes/s"] = Throughput(shapes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_DistanceBetweenShapes(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+
+    for (auto _ : state) {
+        size_t supported = 0;
+        for (size_t i = 1; i < shapes.size(); ++i) {
+            supported += queries::DistanceBetweenShapes(shapes[i - 1], shapes[i]).has_value();
+        }
+        benchmark::DoNotOptimize(supported);
+    }
+
+    state.counters["pairs/s"] = Throughput(shapes.size() - 1);
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_DistanceToPoint, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_DistanceToPoint, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_DistanceToPoint, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_DistanceToPoint, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK_CAPTURE(BM_DistanceBetweenShapes, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_DistanceBetweenShapes, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_DistanceBetweenShapes, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_DistanceBetweenShapes, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,91 @@
+#include "bench_utils.hpp"
+#include "ray_casting.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <numbers>
+
+using namespace geometry;
+using namespace geometry::bench;
+using namespace geometry::intersections;
+
+namespace {
+
+constexpr size_t kRaysCount = 100'000;
+
+// веер лучей из точек сцены: соседние лучи пакета близки по направлению
+std::vector<Ray> GenerateRays(Distribution distribution) {
+    const auto origins = GeneratePoints(distribution, kRaysCount / 64, 21);
+    std::vector<Ray> rays;
+    rays.reserve(kRaysCount);
+    for (const auto &origin : origins) {
+        for (size_t i = 0; i != 64; ++i) {
+            const double angle = 2 * std::numbers::pi * static_cast<double>(i) / 64;
+            rays.push_back({origin, {std::cos(angle), std::sin(angle)}});
+        }
+    }
+    return rays;
+}
+
+}  // namespace
+
+static void BM_RayCasterBuild(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RayCaster{shapes});
+    }
+
+    state.counters["shapes/s"] = Throughput(shapes.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_RayCasterBuild, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+// пакеты по RayCaster::kLanes лучей против обхода по одному лучу
+static void BM_RayCasterFirstHits(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+    const auto rays = GenerateRays(distribution);
+    const RayCaster caster{shapes};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(caster.FirstHits(rays));
+    }
+
+    state.counters["rays/s"] = Throughput(rays.size());
+    state.SetComplexityN(state.range(0));
+}
+
+static void BM_RayCasterFirstHit(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+    const auto rays = GenerateRays(distribution);
+    const RayCaster caster{shapes};
+
+    for (auto _ : state) {
+        for (const auto &ray : rays) {
+            benchmark::DoNotOptimize(caster.FirstHit(ray));
+        }
+    }
+
+    state.counters["rays/s"] = Throughput(rays.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_RayCasterFirstHits, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK_CAPTURE(BM_RayCasterFirstHits, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK_CAPTURE(BM_RayCasterFirstHit, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oLogN);
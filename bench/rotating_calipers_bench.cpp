@@ -0,0 +1,31 @@
+#include "bench_utils.hpp"
+#include "convex_hull.hpp"
+#include "rotating_calipers.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// все range(0) точек на окружности -- вершины оболочки
+template <auto Calipers>
+static void BM_RotatingCalipers(benchmark::State &state) {
+    const auto hull = convex_hull::GrahamScan(GeneratePoints(Distribution::CoCircular, state.range(0))).value();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Calipers(hull));
+    }
+
+    state.counters["vertices/s"] = Throughput(hull.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_RotatingCalipers<convex_hull::FarthestPair>)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oN);
+BENCHMARK(BM_RotatingCalipers<convex_hull::MinAreaRectangle>)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oN);
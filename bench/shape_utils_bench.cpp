@@ -0,0 +1,73 @@
+#include "bench_utils.hpp"
+#include "shape_utils.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// Полный перебор пар, поэтому размер входа ограничен kMaxQuadraticSize
+static void BM_FindAllCollisions(benchmark::State &state, Distribution distribution) {
+    const auto shapes = GenerateShapes(distribution, state.range(0));
+
+    for (auto _ : state) {
+        auto collisions = utils::FindAllCollisions(shapes);
+        benchmark::DoNotOptimize(collisions);
+    }
+
+    const double pairs = static_cast<double>(shapes.size()) * static_cast<double>(shapes.size() - 1) / 2.0;
+    state.counters["pairs/s"] = Throughput(pairs);
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_FindAllCollisions, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK_CAPTURE(BM_FindAllCollisions, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK_CAPTURE(BM_FindAllCollisions, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK_CAPTURE(BM_FindAllCollisions, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNSquared);
+
+static void BM_CounterBasedShapeGenerator(benchmark::State &state, utils::ShapeDistribution distribution) {
+    const utils::CounterBasedShapeGenerator generator{20, distribution};
+    const auto count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        auto shapes = generator.GenerateShapes(count);
+        benchmark::DoNotOptimize(shapes);
+    }
+
+    state.counters["shapes/s"] = Throughput(count);
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_CounterBasedShapeGenerator, uniform, utils::ShapeDistribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_CounterBasedShapeGenerator, clusters, utils::ShapeDistribution::GaussianClusters)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_CounterBasedShapeGenerator, heavy_tailed, utils::ShapeDistribution::HeavyTailed)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Complexity(benchmark::oN);
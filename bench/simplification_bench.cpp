@@ -0,0 +1,80 @@
+#include "bench_utils.hpp"
+#include "simplification.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <numbers>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+namespace {
+
+// оцифрованная граница: окружность радиуса 1000 с шумом до 1
+std::vector<Point2D> DigitisedRing(size_t count) {
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<Point2D> points;
+    points.reserve(count);
+    for (size_t i = 0; i != count; ++i) {
+        const double angle = 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(count);
+        const double radius = 1000.0 + noise(gen);
+        points.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    return points;
+}
+
+}  // namespace
+
+static void BM_DouglasPeucker(benchmark::State &state) {
+    const auto points = DigitisedRing(state.range(0));
+
+    for (auto _ : state) {
+        auto simplified = simplification::DouglasPeucker(points, 2.0);
+        benchmark::DoNotOptimize(simplified);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_DouglasPeucker)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+static void BM_Visvalingam(benchmark::State &state) {
+    const auto points = DigitisedRing(state.range(0));
+
+    for (auto _ : state) {
+        auto simplified = simplification::Visvalingam(points, 10.0);
+        benchmark::DoNotOptimize(simplified);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_Visvalingam)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+// иерархия строится один раз, замеряется выбор уровня по точности
+static void BM_DetailHierarchyLevel(benchmark::State &state) {
+    const simplification::DetailHierarchy hierarchy{DigitisedRing(state.range(0))};
+
+    for (auto _ : state) {
+        auto level = hierarchy.Level(2.0);
+        benchmark::DoNotOptimize(level);
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_DetailHierarchyLevel)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oAuto);
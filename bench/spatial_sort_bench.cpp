@@ -0,0 +1,49 @@
+#include "bench_utils.hpp"
+#include "spatial_sort.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+template <spatial::Curve curve>
+static void BM_CurveOrder(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+
+    for (auto _ : state) {
+        auto order = spatial::CurveOrder(points, curve);
+        benchmark::DoNotOptimize(order);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_CurveOrder<spatial::Curve::Hilbert>)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+
+BENCHMARK(BM_CurveOrder<spatial::Curve::Morton>)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+
+static void BM_BrioOrder(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+
+    for (auto _ : state) {
+        auto order = spatial::BrioOrder(points);
+        benchmark::DoNotOptimize(order);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_BrioOrder)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
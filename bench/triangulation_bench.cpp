@@ -0,0 +1,69 @@
+#include "bench_utils.hpp"
+#include "delaunay_mesh.hpp"
+#include "triangulation.hpp"
+#include <cmath>
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// Текущая реализация квадратичная, поэтому размер входа ограничен kMaxQuadraticSize
+static void BM_DelaunayTriangulation(benchmark::State &state, Distribution distribution) {
+    const auto points = GeneratePoints(distribution, state.range(0));
+
+    // буферы вставки переиспользуются: число аллокаций растёт логарифмически, а не линейно
+    const auto budget = 64 + 4 * static_cast<uint64_t>(std::log2(points.size()));
+    auto triangulate = [&points] { return triangulation::DelaunayTriangulation(points); };
+    if (!CheckAllocationBudget(state, budget, triangulate)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        auto triangles = triangulation::DelaunayTriangulation(points);
+        benchmark::DoNotOptimize(triangles);
+    }
+
+    state.counters["points/s"] = Throughput(points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_DelaunayTriangulation, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+BENCHMARK_CAPTURE(BM_DelaunayTriangulation, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+BENCHMARK_CAPTURE(BM_DelaunayTriangulation, collinear, Distribution::Collinear)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+// все описанные окружности содержат новую точку -- кубическая сложность
+BENCHMARK_CAPTURE(BM_DelaunayTriangulation, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+static void BM_DelaunayMesh(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+    const auto triangles = triangulation::DelaunayTriangulation(points).value();
+
+    for (auto _ : state) {
+        triangulation::DelaunayMesh mesh{points, triangles};
+        benchmark::DoNotOptimize(mesh);
+    }
+
+    state.counters["triangles/s"] = Throughput(triangles.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_DelaunayMesh)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxQuadraticSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
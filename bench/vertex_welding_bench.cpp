@@ -0,0 +1,30 @@
+#include "bench_utils.hpp"
+#include "vertex_welding.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+// каждая точка встречается дважды, как общая вершина соседних треугольников
+static void BM_VertexWelder(benchmark::State &state) {
+    const auto points = GeneratePoints(Distribution::Uniform, state.range(0));
+
+    for (auto _ : state) {
+        spatial::VertexWelder welder{1e-9, points.size()};
+        for (const auto &p : points) {
+            benchmark::DoNotOptimize(welder.Weld(p));
+        }
+        for (const auto &p : points) {
+            benchmark::DoNotOptimize(welder.Weld(p));
+        }
+    }
+
+    state.counters["points/s"] = Throughput(2 * points.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_VertexWelder)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
@@ -0,0 +1,53 @@
+#include "bench_utils.hpp"
+#include "scratch_arena.hpp"
+#include "voronoi.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace geometry;
+using namespace geometry::bench;
+
+static constexpr BoundingBox kBox{-1000.0, -1000.0, 1000.0, 1000.0};
+
+static void BM_FortuneVoronoi(benchmark::State &state, Distribution distribution) {
+    const auto sites = GeneratePoints(distribution, state.range(0));
+
+    for (auto _ : state) {
+        auto diagram = voronoi::FortuneVoronoi(sites, kBox);
+        benchmark::DoNotOptimize(diagram);
+    }
+
+    state.counters["sites/s"] = Throughput(sites.size());
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_FortuneVoronoi, uniform, Distribution::Uniform)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_FortuneVoronoi, clustered, Distribution::Clustered)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+BENCHMARK_CAPTURE(BM_FortuneVoronoi, cocircular, Distribution::CoCircular)
+    ->RangeMultiplier(10)
+    ->Range(kMinSize, kMaxSize / 10)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oNLogN);
+
+// береговая линия и буферы в арене, переиспользуемой между итерациями
+static void BM_FortuneVoronoiArena(benchmark::State &state) {
+    const auto sites = GeneratePoints(Distribution::Uniform, state.range(0));
+    memory::ScratchArena arena{1 << 20};
+
+    for (auto _ : state) {
+        memory::ScratchArena::Scope scope{arena};
+        auto diagram = voronoi::FortuneVoronoi(sites, kBox, scope.Resource());
+        benchmark::DoNotOptimize(diagram);
+    }
+
+    state.counters["sites/s"] = Throughput(sites.size());
+}
+
+BENCHMARK(BM_FortuneVoronoiArena)->RangeMultiplier(10)->Range(kMinSize, kMaxSize / 100)->Unit(benchmark::kMillisecond);
@@ -14,6 +14,7 @@ class GeometryAppConan(ConanFile):
 
     def requirements(self):
         self.requires("gtest/1.13.0")
+        self.requires("benchmark/1.9.1")
     
     def layout(self):
         basic_layout(self, src_folder=".", build_folder="build")
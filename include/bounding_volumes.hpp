@@ -0,0 +1,57 @@
+#pragma once
+#include "geometry.hpp"
+#include "rotating_calipers.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace geometry::queries {
+
+/*
+ * Минимальная охватывающая окружность (алгоритм Welzl в итеративной форме, ожидаемое время O(n))
+ *
+ * Точки перемешиваются генератором с зерном seed, поэтому результат воспроизводим. Пустой вход --
+ * InsufficientPoints
+ */
+GeometryResult<Circle> MinEnclosingCircle(std::span<const Point2D> points, uint32_t seed = 20);
+
+// окружности фигур заменяются описанными n-угольниками: радиус завышен не больше чем на tolerance / cos(pi / n)
+GeometryResult<Circle> MinEnclosingCircle(std::span<const Shape> shapes, ChordTolerance tolerance = {1e-3});
+
+// наименьшая окружность, содержащая фигуру; у многоугольника -- по алгоритму Welzl
+Circle BoundingCircle(const Shape &shape);
+
+// ориентированный прямоугольник наименьшей площади; у окружности -- выровненный по осям квадрат
+convex_hull::OrientedBox BoundingOrientedBox(const Shape &shape);
+
+bool CirclesOverlap(const Circle &lhs, const Circle &rhs) noexcept;
+
+// какими объёмами отсекаются пары в широкой фазе
+enum class BoundingVolume {
+    Box,       // только прямоугольник по осям
+    Tightest,  // все объёмы BoundingVolumes
+};
+
+/*
+ * Все ограничивающие объёмы фигуры
+ *
+ * Overlaps проверяет их от дешёвого к точному: прямоугольник по осям, окружность, ориентированный
+ * прямоугольник. Пересечение объёмов необходимо для пересечения фигур, но не достаточно
+ */
+struct BoundingVolumes {
+    BoundingBox box{0.0, 0.0, 0.0, 0.0};
+    Circle circle{{0.0, 0.0}, 0.0};
+    convex_hull::OrientedBox oriented_box;
+
+    bool Overlaps(const BoundingVolumes &other) const noexcept {
+        return box.Overlaps(other.box) && CirclesOverlap(circle, other.circle) &&
+               oriented_box.Overlaps(other.oriented_box);
+    }
+};
+
+BoundingVolumes GetBoundingVolumes(const Shape &shape);
+
+// пакетный режим: фигуры обрабатываются параллельно
+std::vector<BoundingVolumes> GetBoundingVolumes(std::span<const Shape> shapes);
+
+}  // namespace geometry::queries
@@ -0,0 +1,29 @@
+#pragma once
+#include "geometry.hpp"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace geometry::spatial {
+
+/*
+ * Ближайшая пара точек: разделяй и властвуй за O(n log n)
+ *
+ * Точки сортируются по x поразрядно, непрерывные по x блоки решаются параллельно слиянием по y,
+ * затем пары через границы блоков ищутся в полосах ширины найденного расстояния. Ответ -- номера
+ * во входе, первый меньше второго; меньше двух точек -- InsufficientPoints
+ */
+GeometryResult<std::pair<uint32_t, uint32_t>> ClosestPair(std::span<const Point2D> points);
+
+inline constexpr uint32_t kNoNeighbour = ~uint32_t{0};
+
+/*
+ * Ближайший сосед каждой точки по k-d дереву, запросы выполняются параллельно в порядке дерева
+ *
+ * res[i] -- номер ближайшей к points[i] другой точки (у совпадающих -- её двойник), пары (i, res[i]).
+ * У единственной точки соседа нет: kNoNeighbour
+ */
+std::vector<uint32_t> AllNearestNeighbours(std::span<const Point2D> points);
+
+}  // namespace geometry::spatial
@@ -1,28 +1,58 @@
 #pragma once
 #include "geometry.hpp"
+#include <memory_resource>
 #include <vector>
 
 namespace geometry::convex_hull {
 
 double CrossProduct(Point2D p1, Point2D middle, Point2D p2);
+float CrossProduct(Point2Df p1, Point2Df middle, Point2Df p2);
 
-class StackForGrahamScan {
+template <typename Vector>
+class BasicStackForGrahamScan {
 public:
-    StackForGrahamScan(size_t size) { s.reserve(size); }
+    using Point = typename Vector::value_type;
 
-    void Push(const Point2D &p) { s.push_back(p); }
+    explicit BasicStackForGrahamScan(size_t size, const typename Vector::allocator_type &alloc = {}) : s(alloc) {
+        s.reserve(size);
+    }
+
+    void Push(const Point &p) { s.push_back(p); }
     void Pop() { s.pop_back(); }
 
     size_t Size() { return s.size(); }
-    Point2D Top() { return s.back(); }
-    Point2D NextToTop() { return *std::prev(s.end(), 2); }
+    Point Top() { return s.back(); }
+    Point NextToTop() { return *std::prev(s.end(), 2); }
 
-    std::vector<Point2D> &&Extract() && { return std::move(s); }
+    Vector &&Extract() && { return std::move(s); }
 
 private:
-    std::vector<Point2D> s;
+    Vector s;
 };
 
+using StackForGrahamScan = BasicStackForGrahamScan<std::vector<Point2D>>;
+
 GeometryResult<std::vector<Point2D>> GrahamScan(std::span<const Point2D> points);
 
-}  // namespace geometry::convex_hull
\ No newline at end of file
+GeometryResult<std::vector<Point2Df>> GrahamScan(std::span<const Point2Df> points);
+
+/*
+ * Выпуклая оболочка набора фигур без построения полного облака вершин
+ *
+ * Сначала по опорным функциям фигур в 8 направлениях строится восьмиугольник крайних точек;
+ * фигуры, чей охватывающий прямоугольник строго внутри него, отбрасываются целиком, а от остальных
+ * берутся только вершины снаружи. Окружности разбиваются с точностью tolerance
+ */
+GeometryResult<std::vector<Point2D>> ConvexHullOfShapes(std::span<const Shape> shapes,
+                                                        ChordTolerance tolerance = {1e-3});
+
+// точка фигуры, крайняя в направлении direction
+Point2D SupportPoint(const Shape &shape, Point2D direction);
+
+// Копия входа, стек и результат размещаются в resource (например, в ScratchArena)
+GeometryResult<std::pmr::vector<Point2D>> GrahamScan(std::span<const Point2D> points,
+                                                     std::pmr::memory_resource *resource);
+GeometryResult<std::pmr::vector<Point2Df>> GrahamScan(std::span<const Point2Df> points,
+                                                      std::pmr::memory_resource *resource);
+
+}  // namespace geometry::convex_hull
@@ -0,0 +1,203 @@
+#pragma once
+#include "geometry.hpp"
+#include "triangulation.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace geometry::triangulation {
+
+inline constexpr uint32_t kNoIndex = std::numeric_limits<uint32_t>::max();
+
+/*
+ * Индексированная триангуляция с полурёбрами
+ *
+ * Треугольник t хранит индексы вершин против часовой стрелки, его полуребро h = 3 * t + i
+ * идёт из вершины i в вершину (i + 1) % 3. Twin(h) -- противоположное полуребро соседнего треугольника
+ * или kNoIndex на границе. Соседи, звезда вершины и граничные рёбра перебираются за O(1) на элемент
+ */
+class DelaunayMesh {
+public:
+    using Triangle = std::array<uint32_t, 3>;
+
+    DelaunayMesh() = default;
+
+    // вершины треугольников сопоставляются точкам points по точному совпадению координат
+    DelaunayMesh(std::span<const Point2D> points, std::span<const DelaunayTriangle> triangles);
+
+    std::span<const Point2D> Vertices() const noexcept { return vertices_; }
+    std::span<const Triangle> Triangles() const noexcept { return triangles_; }
+    size_t TrianglesCount() const noexcept { return triangles_.size(); }
+    size_t HalfEdgesCount() const noexcept { return twins_.size(); }
+
+    static constexpr uint32_t Next(uint32_t h) noexcept { return h % 3 == 2 ? h - 2 : h + 1; }
+    static constexpr uint32_t Prev(uint32_t h) noexcept { return h % 3 == 0 ? h + 2 : h - 1; }
+    static constexpr uint32_t TriangleOf(uint32_t h) noexcept { return h / 3; }
+
+    uint32_t Twin(uint32_t h) const noexcept { return twins_[h]; }
+    uint32_t Origin(uint32_t h) const noexcept { return triangles_[h / 3][h % 3]; }
+    uint32_t Target(uint32_t h) const noexcept { return Origin(Next(h)); }
+
+    Point2D Vertex(uint32_t v) const noexcept { return vertices_[v]; }
+    DelaunayTriangle TriangleAt(uint32_t t) const noexcept {
+        const auto &[a, b, c] = triangles_[t];
+        return {vertices_[a], vertices_[b], vertices_[c]};
+    }
+
+    // соседи через рёбра (0-1, 1-2, 2-0); kNoIndex на границе
+    std::array<uint32_t, 3> Neighbours(uint32_t t) const noexcept {
+        std::array<uint32_t, 3> res{};
+        for (uint32_t i = 0; i != 3; ++i) {
+            const uint32_t twin = twins_[3 * t + i];
+            res[i] = twin == kNoIndex ? kNoIndex : TriangleOf(twin);
+        }
+        return res;
+    }
+
+    // полурёбра без пары, граница обходится против часовой стрелки
+    std::span<const uint32_t> BoundaryEdges() const noexcept { return boundary_; }
+
+    // любое исходящее полуребро вершины; у граничной вершины -- граничное, kNoIndex у изолированной
+    uint32_t OutgoingEdge(uint32_t v) const noexcept { return vertex_edges_[v]; }
+
+    /*
+     * Исходящие из вершины полурёбра против часовой стрелки; TriangleOf(h) -- треугольники звезды
+     */
+    class StarRange {
+    public:
+        class Iterator {
+        public:
+            using value_type = uint32_t;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            Iterator(const DelaunayMesh *mesh, uint32_t first, uint32_t current)
+                : mesh_{mesh}, first_{first}, current_{current} {}
+
+            uint32_t operator*() const noexcept { return current_; }
+
+            Iterator &operator++() noexcept {
+                const uint32_t next = mesh_->Twin(Prev(current_));
+                current_ = (next == first_) ? kNoIndex : next;
+                return *this;
+            }
+            Iterator operator++(int) noexcept {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(std::default_sentinel_t) const noexcept { return current_ == kNoIndex; }
+
+        private:
+            const DelaunayMesh *mesh_ = nullptr;
+            uint32_t first_ = kNoIndex;
+            uint32_t current_ = kNoIndex;
+        };
+
+        StarRange(const DelaunayMesh *mesh, uint32_t first) : mesh_{mesh}, first_{first} {}
+
+        Iterator begin() const noexcept { return {mesh_, first_, first_}; }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        const DelaunayMesh *mesh_;
+        uint32_t first_;
+    };
+
+    StarRange VertexStar(uint32_t v) const noexcept { return {this, vertex_edges_[v]}; }
+
+    // обратно в формат DelaunayTriangulation
+    std::vector<DelaunayTriangle> ToTriangles() const;
+
+private:
+    std::vector<Point2D> vertices_;
+    std::vector<Triangle> triangles_;
+    std::vector<uint32_t> twins_;
+    std::vector<uint32_t> vertex_edges_;
+    std::vector<uint32_t> boundary_;
+};
+
+inline DelaunayMesh::DelaunayMesh(std::span<const Point2D> points, std::span<const DelaunayTriangle> triangles)
+    : vertices_(points.begin(), points.end()) {
+    // индекс точки по координатам: сортировка номеров и двоичный поиск
+    std::vector<uint32_t> order(vertices_.size());
+    for (uint32_t i = 0; i != order.size(); ++i) {
+        order[i] = i;
+    }
+    const auto vertex_at = [this](uint32_t i) { return vertices_[i]; };
+    std::ranges::stable_sort(order, std::less{}, vertex_at);
+
+    auto index_of = [&](const Point2D &p) {
+        const auto it = std::ranges::lower_bound(order, p, std::less{}, vertex_at);
+        if (it == order.end() || vertices_[*it].x != p.x || vertices_[*it].y != p.y) {
+            throw std::invalid_argument{"triangle vertex is not in the point set"};
+        }
+        return *it;
+    };
+
+    triangles_.reserve(triangles.size());
+    for (const auto &t : triangles) {
+        Triangle tri{index_of(t.a), index_of(t.b), index_of(t.c)};
+        // все треугольники против часовой стрелки
+        if ((t.b - t.a).Cross(t.c - t.a) < 0) {
+            std::swap(tri[1], tri[2]);
+        }
+        triangles_.push_back(tri);
+    }
+
+    // пары полурёбер: после сортировки по неориентированному ребру соседи в массиве -- близнецы
+    const auto half_edges = static_cast<uint32_t>(3 * triangles_.size());
+    std::vector<std::pair<uint64_t, uint32_t>> keys(half_edges);
+    for (uint32_t h = 0; h != half_edges; ++h) {
+        const uint64_t from = Origin(h);
+        const uint64_t to = Target(h);
+        keys[h] = {from < to ? (from << 32) | to : (to << 32) | from, h};
+    }
+    std::ranges::sort(keys);
+
+    twins_.assign(half_edges, kNoIndex);
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if (keys[i - 1].first == keys[i].first) {
+            twins_[keys[i - 1].second] = keys[i].second;
+            twins_[keys[i].second] = keys[i - 1].second;
+            ++i;
+        }
+    }
+
+    vertex_edges_.assign(vertices_.size(), kNoIndex);
+    for (uint32_t h = 0; h != half_edges; ++h) {
+        auto &edge = vertex_edges_[Origin(h)];
+        if (twins_[h] == kNoIndex) {
+            boundary_.push_back(h);
+            edge = h;
+        } else if (edge == kNoIndex) {
+            edge = h;
+        }
+    }
+}
+
+inline std::vector<DelaunayTriangle> DelaunayMesh::ToTriangles() const {
+    std::vector<DelaunayTriangle> res;
+    res.reserve(triangles_.size());
+    for (uint32_t t = 0; t != triangles_.size(); ++t) {
+        res.push_back(TriangleAt(t));
+    }
+    return res;
+}
+
+inline GeometryResult<DelaunayMesh> DelaunayTriangulationMesh(std::span<const Point2D> points) {
+    const auto triangles = DelaunayTriangulation(points);
+    if (!triangles) {
+        return std::unexpected(triangles.error());
+    }
+    return DelaunayMesh{points, *triangles};
+}
+
+}  // namespace geometry::triangulation
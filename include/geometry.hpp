@@ -2,107 +2,173 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <concepts>
 #include <expected>
 #include <format>
+#include <iterator>
 #include <numbers>
 #include <print>
 #include <ranges>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 namespace geometry {
 
-inline bool are_equals(double a, double b, double epsilon = 1e-9) { return std::abs(a - b) <= epsilon; }
+/*
+ * Допуски сравнений для скалярного типа координат
+ *
+ * Допуски абсолютные и осмысленны для координат порядка 1. У float мантисса 24 бита против 53 у double,
+ * поэтому допуск крупнее, но уже у координат порядка 1e3 шаг сетки float около 6e-5 -- всего полтора шага
+ * до допуска, а дальше допуск меньше шага
+ */
+template <typename T>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<double> {
+    static constexpr double kEpsilon = 1e-9;
+};
+
+template <>
+struct ScalarTraits<float> {
+    static constexpr float kEpsilon = 1e-4f;
+};
 
-inline bool is_equal_zero(double a, double epsilon = 1e-9) { return std::abs(a) <= epsilon; }
+template <typename T>
+concept Scalar = std::floating_point<T> && requires { ScalarTraits<T>::kEpsilon; };
+
+// допуск не участвует в выводе T: are_equals(a_float, b_float, 1e-3) остаётся сравнением float
+template <Scalar T>
+bool are_equals(T a, T b, std::type_identity_t<T> epsilon = ScalarTraits<T>::kEpsilon) {
+    return std::abs(a - b) <= epsilon;
+}
+template <Scalar T>
+bool is_equal_zero(T a, std::type_identity_t<T> epsilon = ScalarTraits<T>::kEpsilon) {
+    return std::abs(a) <= epsilon;
+}
+
+// целые и смешанные аргументы сравниваются в double, как до введения ScalarTraits
+inline bool are_equals(double a, double b, double epsilon = ScalarTraits<double>::kEpsilon) {
+    return std::abs(a - b) <= epsilon;
+}
+inline bool is_equal_zero(double a, double epsilon = ScalarTraits<double>::kEpsilon) { return std::abs(a) <= epsilon; }
 
 /*
  * Добавьте к методам класса Point2D и Lines2DDyn все необходимые аттрибуты и спецификаторы
  * Важно: Возвращаемый тип и принимаемые аргументы менять не нужно
  */
-struct Point2D {
-    double x, y;
+template <Scalar T>
+struct BasicPoint2D {
+    using value_type = T;
+
+    T x, y;
 
-    constexpr Point2D() : x(0), y(0) {}
-    constexpr Point2D(double x, double y) : x(x), y(y) {}
+    constexpr BasicPoint2D() : x(0), y(0) {}
+    constexpr BasicPoint2D(T x, T y) : x(x), y(y) {}
+
+    // переход между точностями только явный
+    template <Scalar U>
+    explicit constexpr operator BasicPoint2D<U>() const noexcept {
+        return {static_cast<U>(x), static_cast<U>(y)};
+    }
 
     // Comparison
-    bool operator<(const Point2D &other) const noexcept { return std::tie(x, y) < std::tie(other.x, other.y); }
-    bool operator==(const Point2D &other) const noexcept { return are_equals(x, other.x) && are_equals(y, other.y); }
+    bool operator<(const BasicPoint2D &other) const noexcept { return std::tie(x, y) < std::tie(other.x, other.y); }
+    bool operator==(const BasicPoint2D &other) const noexcept {
+        return are_equals(x, other.x) && are_equals(y, other.y);
+    }
 
     // Binary math operators
-    Point2D operator+(const Point2D &other) const noexcept { return {x + other.x, y + other.y}; }
-    Point2D operator-(const Point2D &other) const noexcept { return {x - other.x, y - other.y}; }
-    Point2D operator*(double value) const noexcept { return {x * value, y * value}; }
-    Point2D operator/(double value) const noexcept { return {x / value, y / value}; }
+    BasicPoint2D operator+(const BasicPoint2D &other) const noexcept { return {x + other.x, y + other.y}; }
+    BasicPoint2D operator-(const BasicPoint2D &other) const noexcept { return {x - other.x, y - other.y}; }
+    BasicPoint2D operator*(T value) const noexcept { return {x * value, y * value}; }
+    BasicPoint2D operator/(T value) const noexcept { return {x / value, y / value}; }
 
     // Binary geometry operations
-    double Dot(const Point2D &other) const noexcept { return x * other.x + y * other.y; }
-    double Cross(const Point2D &other) const noexcept { return x * other.y - y * other.x; }
-    double Length() const noexcept { return std::sqrt(x * x + y * y); }
-    double DistanceTo(const Point2D &other) const noexcept { return (*this - other).Length(); }
+    T Dot(const BasicPoint2D &other) const noexcept { return x * other.x + y * other.y; }
+    T Cross(const BasicPoint2D &other) const noexcept { return x * other.y - y * other.x; }
+    T Length() const noexcept { return std::sqrt(x * x + y * y); }
+    T DistanceTo(const BasicPoint2D &other) const noexcept { return (*this - other).Length(); }
 
-    Point2D Normalize() {
-        const double len = Length();
-        return len > 0 ? Point2D{x / len, y / len} : Point2D{0, 0};
+    BasicPoint2D Normalize() {
+        const T len = Length();
+        return len > 0 ? BasicPoint2D{x / len, y / len} : BasicPoint2D{0, 0};
     }
 };
 
+using Point2D = BasicPoint2D<double>;
+using Point2Df = BasicPoint2D<float>;
+
+template <typename P>
+concept PointType = std::same_as<P, BasicPoint2D<typename P::value_type>>;
+
 template <std::ranges::random_access_range R>
-    requires std::is_same_v<std::ranges::range_value_t<R>, Point2D>
+    requires PointType<std::ranges::range_value_t<R>>
 void sort_points_clockwise(R &&r) {
-    Point2D mid = std::ranges::fold_left(r, Point2D{0, 0}, std::plus<Point2D>{}) / r.size();
-    std::ranges::sort(r, [&mid](const Point2D &lhs, const Point2D &rhs) {
+    using P = std::ranges::range_value_t<R>;
+    using T = typename P::value_type;
+
+    P mid = std::ranges::fold_left(r, P{0, 0}, std::plus<P>{}) / static_cast<T>(std::ranges::size(r));
+    std::ranges::sort(r, [&mid](const P &lhs, const P &rhs) {
         return std::atan2(lhs.y - mid.y, lhs.x - mid.x) < std::atan2(rhs.y - mid.y, rhs.x - mid.x);
     });
 }
 
-template <size_t N>
+template <size_t N, Scalar T = double>
 struct Lines2D {
-    std::array<double, N> x;
-    std::array<double, N> y;
+    std::array<T, N> x;
+    std::array<T, N> y;
 };
 
-struct Lines2DDyn {
-    std::vector<double> x;
-    std::vector<double> y;
+template <Scalar T>
+struct BasicLines2DDyn {
+    std::vector<T> x;
+    std::vector<T> y;
 
     void Reserve(size_t n) {
         x.reserve(n);
         y.reserve(n);
     }
-    void PushBack(Point2D p) {
+    void PushBack(BasicPoint2D<T> p) {
         x.push_back(p.x);
         y.push_back(p.y);
     }
-    void PushBack(double px, double py) {
+    void PushBack(T px, T py) {
         x.push_back(px);
         y.push_back(py);
     }
-    Point2D Front() { return {x.front(), y.front()}; }
+    BasicPoint2D<T> Front() { return {x.front(), y.front()}; }
 };
 
-struct BoundingBox {
-    double min_x, min_y, max_x, max_y;
+using Lines2DDyn = BasicLines2DDyn<double>;
+
+template <Scalar T>
+struct BasicBoundingBox {
+    T min_x, min_y, max_x, max_y;
 
-    bool Overlaps(const BoundingBox &other) const noexcept {
+    bool Overlaps(const BasicBoundingBox &other) const noexcept {
         bool no_overlap_along_x{max_x < other.min_x || other.max_x < min_x};
         bool no_overlap_along_y{max_y < other.min_y || other.max_y < min_y};
         return !no_overlap_along_x && !no_overlap_along_y;
     }
 
-    double Width() const noexcept { return std::abs(max_x - min_x); }
-    double Height() const noexcept { return std::abs(max_y - min_y); }
+    T Width() const noexcept { return std::abs(max_x - min_x); }
+    T Height() const noexcept { return std::abs(max_y - min_y); }
 
-    Point2D Center() const noexcept { return Point2D{min_x + Width() / 2.0, min_y + Height() / 2.0}; }
+    BasicPoint2D<T> Center() const noexcept { return {min_x + Width() / T{2}, min_y + Height() / T{2}}; }
 
-    bool operator==(const BoundingBox &other) const noexcept {
+    bool operator==(const BasicBoundingBox &other) const noexcept {
         return are_equals(min_x, other.min_x) && are_equals(min_y, other.min_y) && are_equals(max_x, other.max_x) &&
                are_equals(max_y, other.max_y);
     }
 };
 
+using BoundingBox = BasicBoundingBox<double>;
+using BoundingBoxf = BasicBoundingBox<float>;
+
 struct Line {
     Point2D start, end;
 
@@ -212,6 +278,54 @@ struct Rectangle {
     };
 };
 
+// допустимое отклонение хорды от дуги при разбиении окружности на сегменты
+struct ChordTolerance {
+    double max_error;
+};
+
+/*
+ * Минимальное число сегментов, при котором хорды отстоят от окружности радиуса radius не дальше
+ * max_error: radius * (1 - cos(pi / n)) <= max_error
+ */
+inline size_t SegmentsForChordError(double radius, ChordTolerance tolerance, size_t min_segments = 3,
+                                    size_t max_segments = size_t{1} << 16) {
+    radius = std::abs(radius);
+    if (tolerance.max_error >= radius) {
+        return min_segments;
+    }
+    if (tolerance.max_error <= 0.0) {
+        return max_segments;
+    }
+
+    const double segments = std::ceil(std::numbers::pi / std::acos(1.0 - tolerance.max_error / radius));
+    return std::clamp(static_cast<size_t>(segments), min_segments, max_segments);
+}
+
+/*
+ * count равноотстоящих точек окружности, начиная с угла start_angle
+ *
+ * Каждая следующая точка -- поворот предыдущей на постоянный угол, cos/sin считаются один раз
+ */
+template <typename Out>
+void GenerateCirclePoints(Point2D center, double radius, double start_angle, size_t count, Out out) {
+    if (count == 0) {
+        return;
+    }
+
+    const double step = 2.0 * std::numbers::pi / static_cast<double>(count);
+    const double cos_step = std::cos(step);
+    const double sin_step = std::sin(step);
+
+    double dx = radius * std::cos(start_angle);
+    double dy = radius * std::sin(start_angle);
+    for (size_t i = 0; i != count; ++i) {
+        *out++ = Point2D{center.x + dx, center.y + dy};
+        const double next_dx = dx * cos_step - dy * sin_step;
+        dy = dx * sin_step + dy * cos_step;
+        dx = next_dx;
+    }
+}
+
 struct RegularPolygon {
     Point2D center_p;
     double radius;
@@ -227,26 +341,33 @@ struct RegularPolygon {
     double Height() const noexcept { return BoundBox().Height(); }
     Point2D Center() const noexcept { return center_p; }
 
+    // без промежуточного вектора вершин: BoundBox вызывается на горячих путях
     BoundingBox BoundBox() const noexcept {
-        const auto pts = Vertices();
-        if (pts.empty()) {
+        if (sides == 0) {
             return {0.0, 0.0, 0.0, 0.0};
         }
 
-        const auto [min_x, max_x] = std::ranges::minmax(pts, {}, &Point2D::x);
-        const auto [min_y, max_y] = std::ranges::minmax(pts, {}, &Point2D::y);
+        const auto first = Vertex(0);
+        BoundingBox res{first.x, first.y, first.x, first.y};
+        for (int i = 1; i < sides; ++i) {
+            const auto pt = Vertex(i);
+            res.min_x = std::min(res.min_x, pt.x);
+            res.min_y = std::min(res.min_y, pt.y);
+            res.max_x = std::max(res.max_x, pt.x);
+            res.max_y = std::max(res.max_y, pt.y);
+        }
+        return res;
+    }
 
-        return {min_x.x, min_y.y, max_x.x, max_y.y};
+    Point2D Vertex(int i) const noexcept {
+        const double angle = 2 * std::numbers::pi * i / sides;
+        return {center_p.x + radius * std::cos(angle), center_p.y + radius * std::sin(angle)};
     }
 
     std::vector<Point2D> Vertices() const {
         std::vector<Point2D> points;
         points.reserve(sides);
-
-        for (int i = 0; i < sides; ++i) {
-            const double angle = 2 * std::numbers::pi * i / sides;
-            points.emplace_back(center_p.x + radius * std::cos(angle), center_p.y + radius * std::sin(angle));
-        }
+        GenerateCirclePoints(center_p, radius, 0.0, static_cast<size_t>(sides), std::back_inserter(points));
         return points;
     }
 
@@ -284,6 +405,9 @@ struct Circle {
         return {center_p.x - r, center_p.y - r, center_p.x + r, center_p.y + r};
     }
 
+    // число сегментов, при котором хорды отстоят от окружности не дальше tolerance
+    size_t Segments(ChordTolerance tolerance) const { return SegmentsForChordError(radius, tolerance); }
+
     std::vector<Point2D> Vertices(size_t N = 30) const {
         if (N == 0) {
             return {};
@@ -291,15 +415,12 @@ struct Circle {
 
         std::vector<Point2D> points;
         points.reserve(N);
-
-        const double r = std::abs(radius);
-        for (size_t i = 0; i != N; ++i) {
-            const double angle = 2.0 * std::numbers::pi * i / N;
-            points.emplace_back(center_p.x + r * std::cos(angle), center_p.y + r * std::sin(angle));
-        }
+        GenerateCirclePoints(center_p, std::abs(radius), 0.0, N, std::back_inserter(points));
         return points;
     }
+    std::vector<Point2D> Vertices(ChordTolerance tolerance) const { return Vertices(Segments(tolerance)); }
 
+    Lines2DDyn Lines(ChordTolerance tolerance) const { return Lines(Segments(tolerance)); }
     Lines2DDyn Lines(size_t N = 100) const {
         const auto pts = Vertices(N);
         if (N == 0 || pts.empty()) {
@@ -333,6 +454,7 @@ public:
     double Height() const noexcept { return bounding_box_.Height(); }
     Point2D Center() const noexcept { return bounding_box_.Center(); }
     BoundingBox BoundBox() const noexcept { return bounding_box_; }
+    std::span<const Point2D> Points() const noexcept { return points_; }
     std::vector<Point2D> Vertices(size_t N = 30) const noexcept {
         size_t size = std::min(N, points_.size());
 
@@ -381,17 +503,17 @@ using GeometryResult = std::expected<T, GeometryError>;
 
 }  // namespace geometry
 
-template <>
-struct std::formatter<geometry::Point2D> {
+template <geometry::Scalar T>
+struct std::formatter<geometry::BasicPoint2D<T>> {
     constexpr auto parse(std::format_parse_context &ctx) const { return ctx.begin(); }
 
     template <typename FormatContext>
-    auto format(const geometry::Point2D &p, FormatContext &ctx) const {
+    auto format(const geometry::BasicPoint2D<T> &p, FormatContext &ctx) const {
         return format_to(ctx.out(), "({:.2f}, {:.2f})", p.x, p.y);
     }
 };
-template <>
-struct std::formatter<std::vector<geometry::Point2D>> {
+template <geometry::Scalar T>
+struct std::formatter<std::vector<geometry::BasicPoint2D<T>>> {
     bool use_new_line = false;
 
     constexpr auto parse(std::format_parse_context &ctx) {
@@ -415,7 +537,7 @@ struct std::formatter<std::vector<geometry::Point2D>> {
     }
 
     template <typename FormatContext>
-    auto format(const std::vector<geometry::Point2D> &v, FormatContext &ctx) const {
+    auto format(const std::vector<geometry::BasicPoint2D<T>> &v, FormatContext &ctx) const {
         const auto sep = use_new_line ? "\n\t"sv : " "sv;
         for (const auto &p : v) {
             std::format_to(ctx.out(), "{}{}", sep, p);
@@ -0,0 +1,100 @@
+#pragma once
+#include "geometry.hpp"
+#include "plot_batch.hpp"
+#include "triangulation.hpp"
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/*
+ * Отрисовка без gnuplot: экспорт в SVG и растровые PPM/PNG
+ *
+ * Фигуры проходят через BuildShapeBatches (те же серии и уровень детализации, что у Draw),
+ * растр строится встроенным растеризатором: контуры -- отрезками Брезенхэма, заливка -- построчно (even-odd).
+ * Весь вывод идёт через BufferedWriter, поэтому миллион фигур записывается за секунды
+ */
+namespace geometry::visualization {
+
+/*
+ * Буферизованная запись в поток: числа форматируются через std::to_chars без аллокаций
+ */
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::ostream &out, size_t capacity = 1 << 16);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    void Write(std::string_view text);
+    void Write(char c);
+    // число в фиксированной записи с precision знаками после точки
+    void Write(double value, int precision = 2);
+    void Write(size_t value);
+    void WriteBytes(const void *data, size_t size);
+
+    void Flush();
+
+private:
+    std::ostream &out_;
+    std::vector<char> buffer_;
+    size_t size_ = 0;
+};
+
+struct ExportOptions {
+    size_t width = 900;
+    size_t height = 900;
+    // отступ от краёв в пикселях
+    double margin = 10.0;
+    bool level_of_detail = true;
+    // заливка замкнутых контуров полупрозрачным цветом типа фигуры
+    bool fill = false;
+    // подписи с номерами (только SVG); 0 -- без подписей
+    size_t max_labels = 0;
+};
+
+struct Rgb {
+    uint8_t r, g, b;
+
+    bool operator==(const Rgb &) const noexcept = default;
+};
+
+class RasterImage {
+public:
+    RasterImage(size_t width, size_t height, Rgb background = {255, 255, 255});
+
+    size_t Width() const noexcept { return width_; }
+    size_t Height() const noexcept { return height_; }
+
+    Rgb Pixel(size_t x, size_t y) const noexcept { return pixels_[y * width_ + x]; }
+    void SetPixel(int64_t x, int64_t y, Rgb color) noexcept;
+    // смешивание с текущим цветом пикселя, alpha в [0, 1]
+    void BlendPixel(int64_t x, int64_t y, Rgb color, double alpha) noexcept;
+
+    // отрезок Брезенхэма, координаты в пикселях
+    void DrawLine(Point2D from, Point2D to, Rgb color) noexcept;
+    // построчная заливка многоугольника по правилу even-odd
+    void FillPolygon(std::span<const Point2D> ring, Rgb color, double alpha);
+
+    // бинарный PPM (P6)
+    void WritePpm(std::ostream &out) const;
+    // PNG RGB8 без сжатия (deflate stored-блоки), не требует zlib
+    void WritePng(std::ostream &out) const;
+
+private:
+    size_t width_;
+    size_t height_;
+    std::vector<Rgb> pixels_;
+    std::vector<double> crossings_;
+};
+
+void WriteSvg(std::ostream &out, std::span<const Shape> shapes, const ExportOptions &options = {});
+void WriteSvg(std::ostream &out, std::span<const triangulation::DelaunayTriangle> triangles,
+              const ExportOptions &options = {});
+
+RasterImage Rasterize(std::span<const Shape> shapes, const ExportOptions &options = {});
+RasterImage Rasterize(std::span<const triangulation::DelaunayTriangle> triangles, const ExportOptions &options = {});
+
+}  // namespace geometry::visualization
@@ -0,0 +1,133 @@
+#pragma once
+#include "geometry.hpp"
+#include "triangulation.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace geometry::triangulation {
+
+/*
+ * Триангуляция Делоне с вставкой и удалением точек без полной перестройки
+ *
+ * Вставка: поиск треугольника (прыжок к вершине из той же клетки сетки подсказок и проход по соседям), удаление
+ * конфликтующей полости и веер новых треугольников. Удаление: звезда вершины убирается, дыра
+ * заполняется ушами из очереди с приоритетом по степени удалённой точки относительно описанной окружности
+ * уха (у вершины оболочки -- обходом кольца с проверкой пустой окружности). Граница хранится как фиктивные
+ * треугольники с бесконечной вершиной, поэтому результат совпадает с триангуляцией выпуклой оболочки.
+ * Пока все точки на одной прямой, они только запоминаются.
+ * Идентификатор точки сохраняется до её удаления, после чего может быть выдан заново
+ */
+class IncrementalDelaunay {
+public:
+    using VertexId = uint32_t;
+
+    static constexpr VertexId kNoVertex = ~VertexId{0};
+
+    IncrementalDelaunay() = default;
+    explicit IncrementalDelaunay(std::span<const Point2D> points);
+
+    // идентификатор точки; для повторной точки -- идентификатор уже вставленной
+    VertexId Insert(Point2D p);
+
+    // false, если такой точки нет
+    bool Remove(VertexId id);
+
+    bool Contains(VertexId id) const noexcept { return id < alive_index_.size() && alive_index_[id] != kNoVertex; }
+    Point2D Point(VertexId id) const noexcept { return points_[id]; }
+    size_t Size() const noexcept { return alive_.size(); }
+    std::span<const VertexId> Vertices() const noexcept { return alive_; }
+
+    size_t TrianglesCount() const noexcept { return finite_count_; }
+
+    // тот же формат, что у DelaunayTriangulation
+    GeometryResult<std::vector<DelaunayTriangle>> Triangles() const;
+
+private:
+    // вершины против часовой стрелки, n[i] -- сосед через ребро напротив v[i]
+    struct Face {
+        std::array<VertexId, 3> v;
+        std::array<uint32_t, 3> n;
+    };
+
+    // ухо дыры при удалении: вершина кольца, ключ очереди и версия для ленивой отмены
+    struct Ear {
+        double key;
+        uint32_t vertex, version;
+    };
+
+    // ребро границы полости и треугольник за ним
+    struct BoundaryEdge {
+        VertexId a, b;
+        uint32_t outer, outer_index;
+    };
+
+    struct FaceSide {
+        uint32_t face, index;
+    };
+
+    static constexpr VertexId kInfinite = 0;
+    static constexpr uint32_t kNoFace = ~uint32_t{0};
+
+    bool IsGhost(const std::array<VertexId, 3> &v) const noexcept {
+        return v[0] == kInfinite || v[1] == kInfinite || v[2] == kInfinite;
+    }
+    bool Conflicts(const std::array<VertexId, 3> &v, Point2D p) const noexcept;
+
+    VertexId NewVertex(Point2D p);
+    void ReleaseVertex(VertexId id);
+    uint32_t NewFace(const std::array<VertexId, 3> &v);
+    void ReleaseFace(uint32_t face);
+    void Link(uint32_t face, uint32_t i, uint32_t other, uint32_t j) noexcept;
+    uint32_t IndexOf(uint32_t face, uint32_t neighbour) const noexcept;
+
+    void Rebuild();
+    void TryInitialize();
+    size_t GridCell(Point2D p) const noexcept;
+    void RebuildGrid();
+    uint32_t Locate(Point2D p);
+    VertexId InsertIntoTriangulation(VertexId id);
+    bool RemoveFromTriangulation(VertexId id);
+
+    std::vector<Point2D> points_{Point2D{}};
+    std::vector<uint32_t> vertex_face_{kNoFace};
+    std::vector<VertexId> free_vertices_;
+
+    std::vector<VertexId> alive_;
+    std::vector<VertexId> alive_index_{kNoVertex};
+
+    std::vector<Face> faces_;
+    std::vector<uint32_t> free_faces_;
+    size_t finite_count_ = 0;
+    uint32_t last_face_ = kNoFace;
+
+    // точки до появления первой тройки не на одной прямой
+    std::vector<VertexId> pending_;
+    bool initialized_ = false;
+
+    // сетка подсказок для поиска: последняя вставленная вершина каждой клетки, около двух точек на клетку
+    std::vector<VertexId> grid_;
+    BoundingBox grid_box_{};
+    double grid_cell_ = 0;
+    size_t grid_columns_ = 0;
+    size_t grid_rows_ = 0;
+    size_t grid_built_for_ = 0;
+
+    // рабочие буферы
+    std::vector<uint32_t> visited_;
+    uint32_t epoch_ = 0;
+    std::vector<uint32_t> slot_{kNoFace};
+    std::vector<uint32_t> cavity_;
+    std::vector<BoundaryEdge> boundary_;
+    std::vector<VertexId> link_;
+    std::vector<FaceSide> across_;
+    std::vector<size_t> prev_;
+    std::vector<size_t> next_;
+    std::vector<Ear> ears_;
+    std::vector<uint32_t> ear_version_;
+    std::mt19937 gen_{20};
+};
+
+}  // namespace geometry::triangulation
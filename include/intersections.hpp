@@ -64,27 +64,29 @@ public:
             // clang-format on
         };
 
-        std::vector<Point2D> points{};
+        // не более двух точек -- без аллокаций
+        std::array<Point2D, 2> points{};
+        size_t points_count = 0;
 
         if (is_equal_zero(under_root)) {
             const Point2D p{a * c / a2b2, b * c / a2b2};
             if (is_point_inside_segment(p)) {
-                points.push_back(p);
+                points[points_count++] = p;
             }
         } else if (under_root > 0) {
             const Point2D p1{(a * c + b * std::sqrt(under_root)) / a2b2, (b * c - a * std::sqrt(under_root)) / a2b2};
             const Point2D p2{(a * c - b * std::sqrt(under_root)) / a2b2, (b * c + a * std::sqrt(under_root)) / a2b2};
             if (is_point_inside_segment(p1)) {
-                points.push_back(p1);
+                points[points_count++] = p1;
             }
             if (is_point_inside_segment(p2)) {
-                points.push_back(p2);
+                points[points_count++] = p2;
             }
         }
 
-        if (points.empty()) {
+        if (points_count == 0) {
             return std::monostate{};
-        } else if (points.size() == 1) {
+        } else if (points_count == 1) {
             return points.front();
         } else {
             return TwoPoints2D{points[0], points[1]};
@@ -0,0 +1,123 @@
+#pragma once
+#include "geometry.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace geometry::spatial {
+
+/*
+ * Статическое k-d дерево без узлов-указателей
+ *
+ * Точки переставлены так, что диапазон [begin, end) -- поддерево: его медиана по оси разбиения стоит
+ * в середине, левее -- меньшие, правее -- большие. Ось выбирается по большему размаху диапазона,
+ * диапазоны не длиннее kLeafSize -- листья и просматриваются целиком. Построение -- nth_element
+ * на каждом уровне, O(n log n); верхние уровни делятся в вызывающем потоке, поддеревья строятся параллельно.
+ * Обход идёт по стеку фиксированного размера, поэтому запросы не выделяют память
+ */
+class KdTree {
+public:
+    static constexpr uint32_t kNoPoint = ~uint32_t{0};
+    static constexpr size_t kLeafSize = 8;
+
+    struct Neighbour {
+        uint32_t index = kNoPoint;
+        double distance2 = std::numeric_limits<double>::infinity();
+    };
+
+    explicit KdTree(std::span<const Point2D> points);
+
+    size_t Size() const noexcept { return points_.size(); }
+
+    // точки в порядке дерева и их номера во входе: обход в этом порядке сохраняет локальность
+    std::span<const Point2D> Points() const noexcept { return points_; }
+    std::span<const uint32_t> Indices() const noexcept { return indices_; }
+
+    // номер ближайшей к p точки, кроме точки с номером skip; kNoPoint -- если таких нет
+    uint32_t Nearest(Point2D p, uint32_t skip = kNoPoint) const noexcept;
+
+    /*
+     * out.size() ближайших к p точек по возрастанию расстояния, out служит ограниченной кучей.
+     * Возвращает число найденных: меньше out.size(), только если точек в дереве меньше
+     */
+    size_t KNearest(Point2D p, std::span<Neighbour> out) const noexcept;
+
+    // f(index) для каждой точки не дальше radius от p, порядок не определён
+    template <typename F>
+    void ForEachInRadius(Point2D p, double radius, F &&f) const;
+
+    // число точек в замкнутом прямоугольнике; поддеревья целиком внутри считаются без обхода
+    size_t RangeCount(const BoundingBox &box) const noexcept;
+
+    // пакетные запросы выполняются параллельно; у KNearest по k ответов на запрос подряд
+    std::vector<Neighbour> KNearest(std::span<const Point2D> queries, size_t k) const;
+    std::vector<size_t> RangeCount(std::span<const BoundingBox> boxes) const;
+
+private:
+    struct Item {
+        Point2D p;
+        uint32_t index;
+    };
+
+    // диапазон дерева с нижней оценкой квадрата расстояния до него
+    struct Pending {
+        size_t begin, end;
+        double bound;
+    };
+
+    // глубина дерева не больше log2(n) + 1, в стеке обхода не больше одного диапазона на уровень
+    static constexpr size_t kMaxDepth = 64;
+
+    static double Coordinate(Point2D p, uint8_t axis) noexcept { return axis == 0 ? p.x : p.y; }
+
+    void Split(std::span<Item> items, size_t begin, size_t end);
+    void Build(std::span<Item> items, size_t begin, size_t end);
+
+    std::vector<Point2D> points_;
+    std::vector<uint32_t> indices_;
+    // ось разбиения в середине диапазона: 0 -- x, 1 -- y
+    std::vector<uint8_t> axes_;
+    BoundingBox box_{0.0, 0.0, 0.0, 0.0};
+};
+
+template <typename F>
+void KdTree::ForEachInRadius(Point2D p, double radius, F &&f) const {
+    const double radius2 = radius * radius;
+    std::array<Pending, kMaxDepth> stack;
+    size_t top = 0;
+    stack[top++] = {0, points_.size(), 0.0};
+
+    auto visit = [&](size_t i) {
+        const Point2D d = points_[i] - p;
+        if (d.Dot(d) <= radius2) {
+            f(indices_[i]);
+        }
+    };
+
+    while (top != 0) {
+        auto [begin, end, bound] = stack[--top];
+        if (bound > radius2) {
+            continue;
+        }
+        while (end - begin > kLeafSize) {
+            const size_t middle = begin + (end - begin) / 2;
+            visit(middle);
+            const double diff = Coordinate(p, axes_[middle]) - Coordinate(points_[middle], axes_[middle]);
+            if (diff * diff <= radius2) {
+                stack[top++] = diff < 0 ? Pending{middle + 1, end, diff * diff} : Pending{begin, middle, diff * diff};
+            }
+            if (diff < 0) {
+                end = middle;
+            } else {
+                begin = middle + 1;
+            }
+        }
+        for (size_t i = begin; i != end; ++i) {
+            visit(i);
+        }
+    }
+}
+
+}  // namespace geometry::spatial
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/*
+ * Учёт аллокаций для отслеживания регрессий на горячих путях
+ *
+ * Источники событий:
+ *    - подменённые глобальные operator new/delete (src/hooks/new_delete.cpp, линкуются только в тесты и бенчмарки)
+ *    - CountingResource -- std::pmr::memory_resource, считающий обращения к upstream
+ *
+ * Счётчики ведутся на каждый поток отдельно, поэтому замеры в одном потоке не видят аллокаций других потоков
+ */
+namespace geometry::memory {
+
+struct AllocationStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes = 0;
+
+    AllocationStats operator-(const AllocationStats &other) const noexcept {
+        return {allocations - other.allocations, deallocations - other.deallocations, bytes - other.bytes};
+    }
+
+    bool operator==(const AllocationStats &) const noexcept = default;
+};
+
+namespace detail {
+
+inline thread_local constinit AllocationStats thread_stats{};
+
+inline constinit std::atomic<bool> global_hooks_installed{false};
+
+}  // namespace detail
+
+inline void RecordAllocation(size_t bytes) noexcept {
+    ++detail::thread_stats.allocations;
+    detail::thread_stats.bytes += bytes;
+}
+
+inline void RecordDeallocation() noexcept { ++detail::thread_stats.deallocations; }
+
+inline AllocationStats CurrentThreadStats() noexcept { return detail::thread_stats; }
+
+// true, если в программу слинкованы подменённые operator new/delete
+inline bool GlobalHooksInstalled() noexcept { return detail::global_hooks_installed.load(std::memory_order_relaxed); }
+
+/*
+ * Считает аллокации текущего потока с момента создания объекта
+ */
+class ScopedAllocationCounter {
+public:
+    ScopedAllocationCounter() noexcept : start_{CurrentThreadStats()} {}
+
+    AllocationStats Stats() const noexcept { return CurrentThreadStats() - start_; }
+    uint64_t Allocations() const noexcept { return Stats().allocations; }
+    uint64_t Bytes() const noexcept { return Stats().bytes; }
+
+private:
+    AllocationStats start_;
+};
+
+/*
+ * Ресурс-обёртка: пропускает запросы в upstream и считает их
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept
+        : upstream_{upstream} {}
+
+    AllocationStats Stats() const noexcept { return stats_; }
+    void ResetStats() noexcept { stats_ = {}; }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        void *p = upstream_->allocate(bytes, alignment);
+        ++stats_.allocations;
+        stats_.bytes += bytes;
+        return p;
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+        ++stats_.deallocations;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource *upstream_;
+    AllocationStats stats_;
+};
+
+}  // namespace geometry::memory
@@ -0,0 +1,65 @@
+#pragma once
+#include "geometry.hpp"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace geometry::intersections {
+
+using ShapePair = std::pair<uint32_t, uint32_t>;
+
+/*
+ * Точная проверка пересечения фигур после широкой фазы по ограничивающим объёмам
+ *
+ * Фигуры замкнутые, кроме Line (отрезок), касание считается пересечением. Фигуры развёрнуты в окружности
+ * и контуры: выпуклые (Triangle, Rectangle, RegularPolygon, Line) проверяются по разделяющим осям (SAT),
+ * Polygon -- по пересечению рёбер и вложенности, пары с окружностью -- по расстоянию от центра до контура.
+ * Вырожденные выпуклые фигуры (все вершины на одной прямой) сводятся к отрезку.
+ * Пары кандидатов раскладываются по типам и проверяются пачками: внутренние циклы ядер без ветвлений
+ */
+class NarrowPhase {
+public:
+    explicit NarrowPhase(std::span<const Shape> shapes);
+
+    bool Overlaps(uint32_t first, uint32_t second) const noexcept;
+
+    // пересекающиеся пары из candidates в исходном порядке; пачки одного типа проверяются параллельно
+    std::vector<ShapePair> Filter(std::span<const ShapePair> candidates) const;
+
+private:
+    // порядок важен: в паре первой идёт фигура с меньшим видом
+    enum class Kind : uint8_t { Circle, Convex, Polygon, Empty };
+
+    // окружность или контур: вершины [first, first + count), у замкнутого контура первая повторена в конце
+    struct Record {
+        Kind kind = Kind::Empty;
+        bool closed = false;
+        Point2D center;
+        double radius = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+
+        uint32_t Edges() const noexcept { return closed ? count : (count == 0 ? 0 : count - 1); }
+    };
+
+    void AddOutline(Record &record, std::span<const Point2D> points, Kind kind);
+
+    bool CirclesOverlap(const Record &lhs, const Record &rhs) const noexcept;
+    bool CircleOutlineOverlap(const Record &circle, const Record &outline) const noexcept;
+    bool ConvexOverlap(const Record &lhs, const Record &rhs) const noexcept;
+    bool OutlinesOverlap(const Record &lhs, const Record &rhs) const noexcept;
+
+    bool Contains(const Record &outline, Point2D p) const noexcept;
+    // true, если ось не разделяет проекции контуров
+    bool ProjectionsOverlap(const Record &lhs, const Record &rhs, Point2D axis) const noexcept;
+
+    std::vector<Record> records_;
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+};
+
+// одна пара без предварительной широкой фазы
+bool ShapesOverlap(const Shape &lhs, const Shape &rhs);
+
+}  // namespace geometry::intersections
@@ -0,0 +1,44 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace geometry::parallel {
+
+inline size_t ThreadsCount() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+/*
+ * Делит диапазон [0, count) на непрерывные блоки и обрабатывает их в отдельных потоках
+ *
+ * f(begin, end) вызывается по одному разу на блок, первый блок обрабатывается в вызывающем потоке.
+ * Блоки меньше min_chunk_size не создаются, поэтому маленькие входы обрабатываются без потоков.
+ * Важно: исключение из f в рабочем потоке завершает программу
+ */
+template <typename F>
+void ForEachChunk(size_t count, F &&f, size_t min_chunk_size = 4096) {
+    if (count == 0) {
+        return;
+    }
+
+    const size_t min_chunk = std::max<size_t>(min_chunk_size, 1);
+    const size_t chunks = std::min(ThreadsCount(), (count + min_chunk - 1) / min_chunk);
+    if (chunks <= 1) {
+        f(size_t{0}, count);
+        return;
+    }
+
+    const size_t chunk_size = (count + chunks - 1) / chunks;
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks - 1);
+        for (size_t begin = chunk_size; begin < count; begin += chunk_size) {
+            const size_t end = std::min(count, begin + chunk_size);
+            workers.emplace_back([&f, begin, end] { f(begin, end); });
+        }
+
+        f(size_t{0}, chunk_size);
+    }
+}
+
+}  // namespace geometry::parallel
@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace geometry::utils {
+
+/*
+ * Счётчиковый генератор Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+ *
+ * Не хранит состояния: результат зависит только от (counter, key), поэтому i-й элемент
+ * последовательности вычисляется независимо от остальных и в любом потоке
+ */
+class Philox4x32 {
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static constexpr Counter Generate(Counter counter, Key key) noexcept {
+        for (int round = 0; round != 10; ++round) {
+            if (round != 0) {
+                key[0] += kWeyl0;
+                key[1] += kWeyl1;
+            }
+            const uint64_t prod0 = uint64_t{kMul0} * counter[0];
+            const uint64_t prod1 = uint64_t{kMul1} * counter[2];
+            counter = {static_cast<uint32_t>(prod1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(prod1),
+                       static_cast<uint32_t>(prod0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(prod0)};
+        }
+        return counter;
+    }
+
+private:
+    static constexpr uint32_t kMul0 = 0xD2511F53;
+    static constexpr uint32_t kMul1 = 0xCD9E8D57;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+};
+
+/*
+ * Поток случайных чисел для элемента с номером index
+ *
+ * Счётчик Philox: (index, stream, номер блока); каждый блок даёт 4 слова по 32 бита
+ */
+class CounterRandom {
+public:
+    constexpr CounterRandom(uint64_t seed, uint64_t index, uint32_t stream = 0) noexcept
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          index_{index},
+          stream_{stream} {}
+
+    constexpr uint32_t NextU32() noexcept {
+        if (position_ == block_.size()) {
+            const Philox4x32::Counter counter{static_cast<uint32_t>(index_), static_cast<uint32_t>(index_ >> 32),
+                                              stream_, block_index_++};
+            block_ = Philox4x32::Generate(counter, key_);
+            position_ = 0;
+        }
+        return block_[position_++];
+    }
+
+    // равномерно в [0, 1), 53 значащих бита
+    constexpr double Uniform() noexcept {
+        const uint64_t bits = (uint64_t{NextU32()} << 32) | NextU32();
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+    constexpr double Uniform(double min, double max) noexcept { return min + (max - min) * Uniform(); }
+
+    // равномерно в [min, max]
+    constexpr int UniformInt(int min, int max) noexcept {
+        const auto range = static_cast<uint64_t>(static_cast<int64_t>(max) - min + 1);
+        return static_cast<int>(min + static_cast<int64_t>((uint64_t{NextU32()} * range) >> 32));
+    }
+
+    // нормальное распределение (преобразование Бокса-Мюллера)
+    double Normal(double mean, double stddev) noexcept {
+        const double u1 = 1.0 - Uniform();  // (0, 1]
+        const double u2 = Uniform();
+        return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+    }
+
+    // распределение Парето с тяжёлым хвостом: min_value / u^(1 / alpha)
+    double Pareto(double min_value, double alpha) noexcept {
+        const double u = 1.0 - Uniform();  // (0, 1]
+        return min_value / std::pow(u, 1.0 / alpha);
+    }
+
+private:
+    Philox4x32::Key key_;
+    uint64_t index_;
+    uint32_t stream_;
+    uint32_t block_index_ = 0;
+    Philox4x32::Counter block_{};
+    size_t position_ = 4;
+};
+
+}  // namespace geometry::utils
@@ -0,0 +1,62 @@
+#pragma once
+#include "geometry.hpp"
+#include "triangulation.hpp"
+#include <array>
+#include <span>
+#include <variant>
+#include <vector>
+
+/*
+ * Подготовка фигур к отрисовке большими партиями
+ *
+ * Все фигуры одного типа склеиваются в одну серию, контуры разделяются NaN (разрыв линии),
+ * поэтому рисование занимает одну команду на тип, а не на фигуру.
+ * Уровень детализации считается в экранных пикселях: окружности разбиваются так, чтобы хорды отходили
+ * от дуги не больше чем на chord_error_pixels, а фигуры меньше пикселя схлопываются в точки
+ */
+namespace geometry::visualization {
+
+inline constexpr size_t kShapeKinds = std::variant_size_v<Shape>;
+
+struct BatchOptions {
+    // размер пикселя в мировых координатах; 0 -- без упрощения
+    double pixel_size = 0.0;
+    // максимальное число сегментов окружности (как у Circle::Lines по умолчанию)
+    size_t max_circle_segments = 100;
+    // минимальное число сегментов окружности при упрощении
+    size_t min_circle_segments = 8;
+    // допустимое отклонение хорды от окружности в пикселях при упрощении
+    double chord_error_pixels = 0.25;
+    // не больше стольких подписей с номерами фигур; 0 -- без подписей
+    size_t max_labels = 200;
+};
+
+struct Label {
+    Point2D position;
+    size_t index;
+};
+
+struct ShapeBatches {
+    // контуры по номеру альтернативы Shape, разделённые NaN
+    std::array<Lines2DDyn, kShapeKinds> outlines;
+    // центры фигур меньше пикселя, по номеру альтернативы Shape
+    std::array<Lines2DDyn, kShapeKinds> points;
+    std::vector<Label> labels;
+};
+
+// охватывающий прямоугольник всех фигур; для пустого входа -- нулевой
+BoundingBox SceneBoundBox(std::span<const Shape> shapes);
+
+// размер пикселя для сцены, вписанной в квадрат pixels x pixels
+double PixelSize(const BoundingBox &scene, size_t pixels);
+
+// число сегментов окружности радиуса radius с учётом экранного упрощения; не меньше 3 при любых options
+size_t CircleSegments(double radius, const BatchOptions &options);
+
+ShapeBatches BuildShapeBatches(std::span<const Shape> shapes, const BatchOptions &options);
+
+// все треугольники -- одна серия, подписи прореживаются так же, как у фигур
+ShapeBatches BuildTriangleBatches(std::span<const triangulation::DelaunayTriangle> triangles,
+                                  const BatchOptions &options);
+
+}  // namespace geometry::visualization
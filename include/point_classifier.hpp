@@ -0,0 +1,71 @@
+#pragma once
+#include "geometry.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace geometry::queries {
+
+/*
+ * Массовая классификация точек по многоугольным регионам
+ *
+ * Охватывающие прямоугольники регионов разложены по равномерной сетке (около двух клеток на ребро).
+ * Для каждой клетки хранится список регионов, чей прямоугольник её задевает: клетка целиком внутри
+ * региона отвечает сразу, а через граничную клетку проходит граница, и точка проверяется подсчётом
+ * пересечений луча. Рёбра региона разложены по горизонтальным полосам и хранятся раздельными массивами
+ * координат, дополненными до kLanes, поэтому проверка -- короткий цикл без ветвлений только по рёбрам
+ * полосы точки. Предикат пересечения тот же, что в PointToShapeDistanceVisitor.
+ * Пакеты точек делятся на блоки и обрабатываются параллельно
+ */
+class RegionClassifier {
+public:
+    static constexpr uint32_t kNoRegion = ~uint32_t{0};
+    static constexpr size_t kLanes = 4;
+
+    explicit RegionClassifier(std::span<const Polygon> regions);
+
+    // номер региона, содержащего точку; при пересечении регионов -- наименьший, kNoRegion -- вне всех
+    uint32_t Classify(Point2D p) const noexcept;
+
+    // ответы в порядке points
+    std::vector<uint32_t> Classify(std::span<const Point2D> points) const;
+
+    size_t RegionsCount() const noexcept { return regions_.size(); }
+
+private:
+    // горизонтальные полосы рёбер одного региона
+    struct RegionSlabs {
+        double min_y = 0;
+        double inverse_height = 0;
+        uint32_t slabs_count = 0;
+        uint32_t first_slab = 0;
+    };
+
+    // старший бит элемента клетки: клетка целиком внутри региона
+    static constexpr uint32_t kInside = 1u << 31;
+
+    void BuildSlabs(std::span<const Polygon> regions);
+    void BuildGrid(std::span<const Polygon> regions);
+
+    uint32_t SlabOf(const RegionSlabs &region, double y) const noexcept;
+    bool Contains(uint32_t region, Point2D p) const noexcept;
+    size_t CellOf(Point2D p) const noexcept;
+    BoundingBox CellBox(size_t column, size_t row) const noexcept;
+
+    std::vector<RegionSlabs> regions_;
+    std::vector<uint32_t> slab_offsets_;
+    // ребро i -- от (x0, y0) к (x1, y1), как пара (текущая, предыдущая) вершины
+    std::vector<double> x0_;
+    std::vector<double> y0_;
+    std::vector<double> x1_;
+    std::vector<double> y1_;
+
+    BoundingBox box_{0.0, 0.0, 0.0, 0.0};
+    double cell_ = 0;
+    size_t columns_ = 0;
+    size_t rows_ = 0;
+    std::vector<uint32_t> cell_offsets_;
+    std::vector<uint32_t> cell_entries_;
+};
+
+}  // namespace geometry::queries
@@ -0,0 +1,51 @@
+#pragma once
+#include "delaunay_mesh.hpp"
+#include "geometry.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace geometry::triangulation {
+
+/*
+ * Поиск треугольника, содержащего точку (jump-and-walk)
+ *
+ * Из вершин сетки выбирается около n^(1/3) опорных. Запрос начинается с ближайшей опорной вершины
+ * и идёт по соседям через ребро, относительно которого точка лежит снаружи (тест ориентации).
+ * Пакетные запросы упорядочиваются по кривой Гильберта, и каждый следующий путь начинается
+ * с треугольника предыдущего ответа. Граница триангуляции может быть невыпуклой: если путь упёрся
+ * в границу внутри выпуклой оболочки, он продолжается с последнего пересечения отрезка до точки
+ * с границей, а перебор треугольников остаётся запасным вариантом.
+ * Сетка должна жить дольше локатора
+ */
+class PointLocator {
+public:
+    explicit PointLocator(const DelaunayMesh &mesh, size_t landmarks = 0);
+
+    // индекс треугольника или kNoIndex, если точка вне триангуляции; точка на ребре относится к любому из двух
+    uint32_t Locate(Point2D p) const;
+
+    // путь начинается с треугольника hint
+    uint32_t Locate(Point2D p, uint32_t hint) const;
+
+    // ответы в порядке queries
+    std::vector<uint32_t> Locate(std::span<const Point2D> queries) const;
+
+    size_t LandmarksCount() const noexcept { return landmark_points_.size(); }
+
+private:
+    uint32_t NearestLandmark(Point2D p) const;
+    uint32_t Walk(uint32_t triangle, Point2D p) const;
+    bool OutsideHull(Point2D p) const;
+    Point2D Centroid(uint32_t triangle) const;
+    // граничное полуребро, пересекающее отрезок from-to ближе всего к to
+    uint32_t LastBoundaryCrossing(Point2D from, Point2D to) const;
+    uint32_t Scan(Point2D p) const;
+
+    const DelaunayMesh &mesh_;
+    std::vector<Point2D> landmark_points_;
+    std::vector<uint32_t> landmark_triangles_;
+    std::vector<Point2D> hull_;
+};
+
+}  // namespace geometry::triangulation
@@ -0,0 +1,60 @@
+#pragma once
+#include "geometry.hpp"
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace geometry {
+
+enum class Winding { Clockwise = -1, Degenerate = 0, CounterClockwise = 1 };
+
+struct PolygonMetrics {
+    // > 0 для обхода против часовой стрелки
+    double signed_area = 0;
+    // центр масс области; у вырожденного многоугольника -- среднее вершин
+    Point2D centroid;
+    double perimeter = 0;
+    Winding winding = Winding::Degenerate;
+
+    double Area() const noexcept { return std::abs(signed_area); }
+};
+
+/*
+ * Вершины многоугольника в раздельных массивах x и y (structure of arrays)
+ *
+ * Массивы дополнены копиями первой вершины до длины, кратной kLanes, плюс одна: ребро i -- (i, i + 1)
+ * для всех i без проверки границ, а рёбра дополнения вырождены и ничего не добавляют к сумме.
+ * Ядра обрабатывают по kLanes рёбер независимыми аккумуляторами, что компилятор переводит в векторные
+ * инструкции; площадь, центр масс, периметр и направление обхода считаются за один проход
+ */
+class PolygonSoA {
+public:
+    // число независимых аккумуляторов; отдельных флагов набора инструкций сборка не задаёт
+    static constexpr size_t kLanes = 4;
+
+    explicit PolygonSoA(std::span<const Point2D> points);
+    explicit PolygonSoA(const Polygon &polygon) : PolygonSoA(polygon.Points()) {}
+
+    size_t Size() const noexcept { return size_; }
+    std::span<const double> Xs() const noexcept { return std::span{xs_}.first(size_); }
+    std::span<const double> Ys() const noexcept { return std::span{ys_}.first(size_); }
+    Point2D Vertex(size_t i) const noexcept { return {xs_[i], ys_[i]}; }
+
+    // считается в конструкторе по массивам x и y
+    BoundingBox BoundBox() const noexcept { return bounding_box_; }
+
+    PolygonMetrics Metrics() const noexcept;
+
+    Polygon ToPolygon() const;
+
+private:
+    size_t size_ = 0;
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    BoundingBox bounding_box_{0.0, 0.0, 0.0, 0.0};
+};
+
+// пакетный режим: многоугольники обрабатываются параллельно
+std::vector<PolygonMetrics> Metrics(std::span<const PolygonSoA> polygons);
+
+}  // namespace geometry
@@ -0,0 +1,174 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/*
+ * Инструментирование конвейера: таймеры областей видимости, монотонные счётчики и
+ * кольцевые буферы событий на каждый поток
+ *
+ * Точки замера расставляются макросами GEOMETRY_PROFILE_SCOPE / GEOMETRY_PROFILE_COUNT.
+ * Без GEOMETRY_ENABLE_PROFILING макросы раскрываются в пустоту, поэтому их можно оставлять в релизной сборке
+ */
+
+#define GEOMETRY_PROFILING_CONCAT_IMPL(a, b) a##b
+#define GEOMETRY_PROFILING_CONCAT(a, b) GEOMETRY_PROFILING_CONCAT_IMPL(a, b)
+
+#ifdef GEOMETRY_ENABLE_PROFILING
+#define GEOMETRY_PROFILE_SCOPE(name)                                                                                   \
+    static const uint32_t GEOMETRY_PROFILING_CONCAT(geometry_profile_id_, __LINE__) =                                 \
+        ::geometry::profiling::RegisterScope(name);                                                                    \
+    ::geometry::profiling::ScopedTimer GEOMETRY_PROFILING_CONCAT(geometry_profile_scope_, __LINE__) {                 \
+        name, GEOMETRY_PROFILING_CONCAT(geometry_profile_id_, __LINE__)                                                \
+    }
+#define GEOMETRY_PROFILE_COUNT(counter, n)                                                                             \
+    ::geometry::profiling::AddCount(::geometry::profiling::Counter::counter, static_cast<uint64_t>(n))
+#else
+#define GEOMETRY_PROFILE_SCOPE(name) static_cast<void>(0)
+#define GEOMETRY_PROFILE_COUNT(counter, n) static_cast<void>(0)
+#endif
+
+namespace geometry::profiling {
+
+#ifdef GEOMETRY_ENABLE_PROFILING
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+enum class Counter : size_t { PredicateEvaluations, CandidatePairs, TrianglesVisited, Count };
+
+inline constexpr size_t kCountersNumber = static_cast<size_t>(Counter::Count);
+
+std::string_view CounterName(Counter counter) noexcept;
+
+struct TraceEvent {
+    // имя должно жить всё время работы программы (строковый литерал)
+    const char *name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+};
+
+/*
+ * Таблица областей видимости фиксированного размера
+ *
+ * Номер выдаётся один раз на точку замера (GEOMETRY_PROFILE_SCOPE хранит его в статической переменной),
+ * одинаковые имена получают один номер. Сверх kMaxScopes - 1 имён все области попадают в последний
+ * общий слот, поэтому запись итогов никогда не выделяет память
+ */
+inline constexpr size_t kMaxScopes = 256;
+
+uint32_t RegisterScope(const char *name);
+
+// число выданных номеров и имя по номеру
+size_t ScopesCount() noexcept;
+std::string_view ScopeName(uint32_t scope) noexcept;
+
+// итоги одной области видимости: не зависят от переполнения кольцевого буфера
+struct ScopeStats {
+    uint64_t calls = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+/*
+ * Буфер событий одного потока
+ *
+ * Пишет только поток-владелец, при переполнении самые старые события затираются;
+ * итоги по областям копятся отдельно в слотах таблицы областей и не теряются
+ */
+class ThreadBuffer {
+public:
+    static constexpr size_t kCapacity = 8192;
+
+    explicit ThreadBuffer(uint32_t thread_id) : thread_id_{thread_id} {}
+
+    // scope -- номер из RegisterScope
+    void Record(const TraceEvent &event, uint32_t scope) noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        events_[head % kCapacity] = event;
+        head_.store(head + 1, std::memory_order_release);
+
+        auto &stats = scopes_[scope];
+        ++stats.calls;
+        stats.total_ns += event.duration_ns;
+        stats.max_ns = std::max(stats.max_ns, event.duration_ns);
+    }
+
+    void Add(Counter counter, uint64_t n) noexcept {
+        // единственный писатель -- обходимся без атомарного read-modify-write
+        auto &value = counters_[static_cast<size_t>(counter)];
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    uint32_t ThreadId() const noexcept { return thread_id_; }
+    uint64_t CounterValue(Counter counter) const noexcept {
+        return counters_[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+    // события в порядке записи, не более kCapacity последних
+    std::vector<TraceEvent> Events() const;
+
+    // итоги по всем событиям с последней очистки, по номерам областей
+    std::span<const ScopeStats, kMaxScopes> Scopes() const noexcept { return scopes_; }
+
+    void Clear() noexcept;
+
+private:
+    uint32_t thread_id_;
+    std::atomic<uint64_t> head_{0};
+    std::array<TraceEvent, kCapacity> events_{};
+    std::array<std::atomic<uint64_t>, kCountersNumber> counters_{};
+    std::array<ScopeStats, kMaxScopes> scopes_{};
+};
+
+// Буфер текущего потока, создаётся и регистрируется при первом обращении
+ThreadBuffer &CurrentThreadBuffer();
+
+// Наносекунды от момента запуска программы
+uint64_t NowNs() noexcept;
+
+inline void AddCount(Counter counter, uint64_t n) noexcept { CurrentThreadBuffer().Add(counter, n); }
+
+class ScopedTimer {
+public:
+    ScopedTimer(const char *name, uint32_t scope) noexcept : name_{name}, scope_{scope}, start_ns_{NowNs()} {}
+    // номер ищется по имени под мьютексом; на горячих путях -- GEOMETRY_PROFILE_SCOPE
+    explicit ScopedTimer(const char *name) : ScopedTimer(name, RegisterScope(name)) {}
+    ~ScopedTimer() { CurrentThreadBuffer().Record({name_, start_ns_, NowNs() - start_ns_}, scope_); }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    const char *name_;
+    uint32_t scope_;
+    uint64_t start_ns_;
+};
+
+/*
+ * Функции экспорта читают буферы всех потоков
+ *
+ * Важно: вызывать, когда рабочие потоки не пишут события (например, в конце программы)
+ */
+
+// Суммарное значение счётчика по всем потокам
+uint64_t TotalCount(Counter counter);
+
+// JSON в формате Chrome trace-event (chrome://tracing, Perfetto)
+void WriteChromeTrace(std::ostream &out);
+
+// Таблица: имя области, число вызовов, суммарное/среднее/максимальное время, затем счётчики
+void PrintSummary(std::ostream &out);
+
+// Очищает события и счётчики всех потоков
+void Reset();
+
+}  // namespace geometry::profiling
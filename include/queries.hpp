@@ -54,7 +54,7 @@ struct PointToShapeDistanceVisitor {
 
     double operator()(const Triangle &triangle) const {
         const auto pts = triangle.Vertices();
-        std::vector<double> vprods(pts.size());
+        std::array<double, 3> vprods{};
         for (size_t i = 0, j = pts.size() - 1; i < pts.size(); j = i++) {
             const auto v1 = pts[j] - pts[i];
             const auto v2 = point - pts[i];
@@ -73,33 +73,41 @@ struct PointToShapeDistanceVisitor {
     }
 
     double operator()(const RegularPolygon &poly) const {
-        const auto pts = poly.Vertices();
-        return operator()(Polygon{pts});
+        return DistanceToClosedPolygon(static_cast<size_t>(poly.sides),
+                                       [&poly](size_t i) { return poly.Vertex(static_cast<int>(i)); });
     }
 
     double operator()(const Polygon &poly) const {
-        const auto &pts = poly.Vertices();
-        if (pts.empty()) {
+        const auto pts = poly.Points();
+        return DistanceToClosedPolygon(pts.size(), [&pts](size_t i) { return pts[i]; });
+    }
+
+private:
+    // Вершины запрашиваются по индексу, чтобы не строить промежуточные вектора вершин и рёбер
+    template <typename VertexAt>
+    double DistanceToClosedPolygon(size_t size, VertexAt &&vertex_at) const {
+        if (size == 0) {
             return std::numeric_limits<double>::infinity();
         }
 
-        if (pts.size() == 1) {
-            return point.DistanceTo(pts[0]);
+        if (size == 1) {
+            return point.DistanceTo(vertex_at(0));
         }
 
         bool is_inside = false;
-        for (size_t i = 0, j = pts.size() - 1; i < pts.size(); j = i++) {
-            if (((pts[i].y > point.y) != (pts[j].y > point.y)) &&
-                (point.x < (pts[j].x - pts[i].x) * (point.y - pts[i].y) / (pts[j].y - pts[i].y) + pts[i].x)) {
+        double min_distance = std::numeric_limits<double>::infinity();
+        Point2D prev = vertex_at(size - 1);
+        for (size_t i = 0; i < size; ++i) {
+            const Point2D cur = vertex_at(i);
+            if (((cur.y > point.y) != (prev.y > point.y)) &&
+                (point.x < (prev.x - cur.x) * (point.y - cur.y) / (prev.y - cur.y) + cur.x)) {
                 is_inside = !is_inside;
             }
-        }
-        if (is_inside) {
-            return 0.0;
+            min_distance = std::min(min_distance, operator()(Line{prev, cur}));
+            prev = cur;
         }
 
-        auto distances = poly.Edges() | vs::transform([this](const Line &e) { return operator()(e); });
-        return std::ranges::min(distances);
+        return is_inside ? 0.0 : min_distance;
     }
 };
 
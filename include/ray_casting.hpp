@@ -0,0 +1,96 @@
+#pragma once
+#include "geometry.hpp"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace geometry::intersections {
+
+// точки origin + direction * t для t из [0, max_t]; отрезок -- луч с max_t = 1
+struct Ray {
+    Point2D origin;
+    Point2D direction;
+    double max_t = std::numeric_limits<double>::infinity();
+
+    static Ray FromSegment(const Line &segment) noexcept { return {segment.start, segment.Direction(), 1.0}; }
+
+    Point2D At(double t) const noexcept { return origin + direction * t; }
+};
+
+struct RayHit {
+    uint32_t shape;
+    double t;
+    Point2D point;
+};
+
+/*
+ * Пересечение лучей с границами фигур сцены
+ *
+ * Фигуры лежат в иерархии охватывающих прямоугольников (BVH, разбиение по медиане центров), многоугольные
+ * фигуры развёрнуты в массивы рёбер. Лучи обходят иерархию пакетами по kLanes: проверки прямоугольников
+ * узлов (slab), окружностей и рёбер -- циклы по лучам пакета без ветвлений, которые компилятор переводит
+ * в векторные инструкции. Ближнее поддерево обходится первым, дальнее отсекается по найденному попаданию.
+ * Параллельные или коллинеарные ребру лучи его не пересекают, как в IntersectionVisitor
+ */
+class RayCaster {
+public:
+    static constexpr size_t kLanes = 4;
+    static constexpr size_t kLeafSize = 4;
+
+    explicit RayCaster(std::span<const Shape> shapes);
+
+    // ближайшее попадание
+    std::optional<RayHit> FirstHit(const Ray &ray) const;
+
+    // все задетые фигуры по возрастанию t, каждая -- один раз, в первой точке границы
+    std::vector<RayHit> AllHits(const Ray &ray) const;
+
+    // пакетный режим: пакеты лучей обрабатываются параллельно, соседние лучи лучше делать близкими
+    std::vector<std::optional<RayHit>> FirstHits(std::span<const Ray> rays) const;
+
+    size_t ShapesCount() const noexcept { return shapes_.size(); }
+
+private:
+    // окружность или рёбра [first_edge, first_edge + edges_count)
+    struct ShapeRecord {
+        BoundingBox box;
+        Point2D center;
+        double radius = 0;
+        uint32_t first_edge = 0;
+        uint32_t edges_count = 0;
+        bool circle = false;
+    };
+
+    // лист: фигуры order_[first, first + count); внутренний узел: левый ребёнок следующий, правый -- first
+    struct Node {
+        BoundingBox box;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint8_t axis = 0;
+    };
+
+    struct Packet;
+
+    uint32_t BuildNode(size_t begin, size_t end, std::span<const Point2D> centers);
+
+    template <typename OnHit>
+    void Traverse(const Packet &packet, std::span<const double> limits, OnHit &&on_hit) const;
+    void IntersectShape(uint32_t shape, const Packet &packet, std::span<const double> limits,
+                        std::span<double> res) const noexcept;
+
+    void Cast(std::span<const Ray> rays, std::span<std::optional<RayHit>> res) const;
+
+    std::vector<ShapeRecord> shapes_;
+    // рёбра: начало (x0, y0) и вектор (ex, ey)
+    std::vector<double> x0_;
+    std::vector<double> y0_;
+    std::vector<double> ex_;
+    std::vector<double> ey_;
+
+    std::vector<uint32_t> order_;
+    std::vector<Node> nodes_;
+};
+
+}  // namespace geometry::intersections
@@ -0,0 +1,76 @@
+#pragma once
+#include "geometry.hpp"
+#include <array>
+#include <cmath>
+#include <span>
+
+namespace geometry::convex_hull {
+
+/*
+ * Ориентированный прямоугольник: центр, единичное направление axis и полуразмеры вдоль axis
+ * и перпендикуляра к нему
+ */
+struct OrientedBox {
+    Point2D center;
+    Point2D axis{1., 0.};
+    double half_length = 0;
+    double half_width = 0;
+
+    Point2D Normal() const noexcept { return {-axis.y, axis.x}; }
+
+    double Area() const noexcept { return 4 * half_length * half_width; }
+    double Perimeter() const noexcept { return 4 * (half_length + half_width); }
+
+    // углы против часовой стрелки
+    std::array<Point2D, 4> Corners() const noexcept {
+        const Point2D u = axis * half_length;
+        const Point2D v = Normal() * half_width;
+        return {center - u - v, center + u - v, center + u + v, center - u + v};
+    }
+
+    BoundingBox BoundBox() const noexcept {
+        const double dx = std::abs(axis.x) * half_length + std::abs(axis.y) * half_width;
+        const double dy = std::abs(axis.y) * half_length + std::abs(axis.x) * half_width;
+        return {center.x - dx, center.y - dy, center.x + dx, center.y + dy};
+    }
+
+    // теорема о разделяющей оси: достаточно проверить стороны обоих прямоугольников
+    bool Overlaps(const OrientedBox &other) const noexcept {
+        const Point2D d = other.center - center;
+        auto separated = [&](Point2D n) {
+            const double r = half_length * std::abs(axis.Dot(n)) + half_width * std::abs(Normal().Dot(n)) +
+                             other.half_length * std::abs(other.axis.Dot(n)) +
+                             other.half_width * std::abs(other.Normal().Dot(n));
+            return std::abs(d.Dot(n)) > r;
+        };
+        return !separated(axis) && !separated(Normal()) && !separated(other.axis) && !separated(other.Normal());
+    }
+};
+
+struct PointPair {
+    Point2D first, second;
+
+    double Distance() const noexcept { return first.DistanceTo(second); }
+};
+
+/*
+ * Вращающиеся штангенциркули за O(h) по выпуклой оболочке
+ *
+ * hull -- вершины выпуклого многоугольника в порядке обхода, как их возвращает GrahamScan.
+ * Допустимы обход по часовой стрелке, повторяющиеся и коллинеарные вершины. Пустая оболочка --
+ * InsufficientPoints, у одной точки или отрезка ширина и площадь прямоугольника нулевые
+ */
+
+// самая далёкая пара вершин
+GeometryResult<PointPair> FarthestPair(std::span<const Point2D> hull);
+
+GeometryResult<double> Diameter(std::span<const Point2D> hull);
+
+// наименьшее расстояние между параллельными опорными прямыми
+GeometryResult<double> Width(std::span<const Point2D> hull);
+
+// одна из сторон оптимального прямоугольника лежит на ребре оболочки
+GeometryResult<OrientedBox> MinAreaRectangle(std::span<const Point2D> hull);
+GeometryResult<OrientedBox> MinPerimeterRectangle(std::span<const Point2D> hull);
+
+}  // namespace geometry::convex_hull
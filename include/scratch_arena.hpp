@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/*
+ * Арена для временных буферов алгоритмов (GrahamScan, DelaunayTriangulation и т.п.)
+ *
+ * Память выделяется из собственного буфера монотонно и освобождается целиком через Reset(),
+ * поэтому повторные вызовы в цикле (по кадрам, по партиям точек) не обращаются к глобальному new.
+ * Если буфера не хватает, арена берёт блоки у upstream и держит их до Reset()
+ */
+namespace geometry::memory {
+
+class ScratchArena {
+public:
+    static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+    explicit ScratchArena(size_t capacity = kDefaultCapacity,
+                          std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : buffer_{std::make_unique_for_overwrite<std::byte[]>(capacity)},
+          capacity_{capacity},
+          resource_{buffer_.get(), capacity_, upstream} {}
+
+    ScratchArena(const ScratchArena &) = delete;
+    ScratchArena &operator=(const ScratchArena &) = delete;
+
+    std::pmr::memory_resource *Resource() noexcept { return &resource_; }
+    size_t Capacity() const noexcept { return capacity_; }
+
+    // все объекты, размещённые в арене, должны быть уничтожены до вызова
+    void Reset() noexcept { resource_.release(); }
+
+    /*
+     * Сбрасывает арену при выходе из области видимости
+     */
+    class Scope {
+    public:
+        explicit Scope(ScratchArena &arena) noexcept : arena_{arena} {}
+        ~Scope() { arena_.Reset(); }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        std::pmr::memory_resource *Resource() noexcept { return arena_.Resource(); }
+
+    private:
+        ScratchArena &arena_;
+    };
+
+private:
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t capacity_;
+    std::pmr::monotonic_buffer_resource resource_;
+};
+
+// своя арена у каждого потока, создаётся при первом обращении
+inline ScratchArena &ThreadScratchArena() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+}  // namespace geometry::memory
@@ -1,5 +1,10 @@
 #pragma once
+#include "bounding_volumes.hpp"
 #include "geometry.hpp"
+#include "narrow_phase.hpp"
+#include "parallel.hpp"
+#include "philox.hpp"
+#include "profiling.hpp"
 #include "queries.hpp"
 #include <optional>
 #include <print>
@@ -46,6 +51,8 @@ public:
     }
 
     std::vector<Shape> GenerateShapes(size_t count) {
+        GEOMETRY_PROFILE_SCOPE("utils::ShapeGenerator::GenerateShapes");
+
         std::vector<Shape> shapes;
         shapes.reserve(count);
 
@@ -64,7 +71,174 @@ private:
     std::uniform_int_distribution<int> type_dist;
 };
 
-inline std::vector<std::pair<Shape, Shape>> FindAllCollisions(std::span<const Shape> shapes) {
+enum class ShapeDistribution {
+    Uniform,           // центры и размеры равномерно
+    GaussianClusters,  // центры -- нормальное распределение вокруг случайных центров кластеров
+    Grid,              // центры привязаны к узлам сетки, прямоугольники выровнены по ней
+    HeavyTailed,       // размеры по Парето: много мелких фигур и редкие очень крупные
+    Degenerate,        // вырожденные фигуры: нулевые размеры, коллинеарные вершины, общая прямая
+};
+
+/*
+ * Детерминированный генератор фигур на счётчиковом ГСЧ (Philox)
+ *
+ * Фигура с номером i зависит только от (seed, i): генерацию можно делить между потоками
+ * и на части, результат побитово совпадает с последовательным
+ */
+class CounterBasedShapeGenerator {
+public:
+    struct Options {
+        double min_coord = -100.0;
+        double max_coord = 100.0;
+        double min_size = 1.0;
+        double max_size = 20.0;
+        size_t clusters = 16;
+        double cluster_stddev = 5.0;
+        double grid_step = 10.0;
+        double pareto_alpha = 1.5;
+    };
+
+    explicit CounterBasedShapeGenerator(uint64_t seed, ShapeDistribution distribution = ShapeDistribution::Uniform)
+        : CounterBasedShapeGenerator(seed, distribution, Options{}) {}
+
+    CounterBasedShapeGenerator(uint64_t seed, ShapeDistribution distribution, Options options)
+        : seed_{seed}, distribution_{distribution}, options_{options} {
+        if (options_.min_coord > options_.max_coord || options_.min_size > options_.max_size ||
+            options_.clusters == 0 || options_.grid_step <= 0.0 || options_.pareto_alpha <= 0.0) {
+            throw std::invalid_argument{"invalid shape generator options"};
+        }
+    }
+
+    Shape GenerateShape(size_t index) const {
+        CounterRandom random{seed_, index, kShapeStream};
+
+        switch (distribution_) {
+        case ShapeDistribution::Uniform: {
+            const Point2D center{random.Uniform(options_.min_coord, options_.max_coord),
+                                 random.Uniform(options_.min_coord, options_.max_coord)};
+            return MakeShape(random, center, random.Uniform(options_.min_size, options_.max_size));
+        }
+        case ShapeDistribution::GaussianClusters: {
+            const int cluster_index = random.UniformInt(0, static_cast<int>(options_.clusters) - 1);
+            const auto cluster = ClusterCenter(static_cast<size_t>(cluster_index));
+            const Point2D center{random.Normal(cluster.x, options_.cluster_stddev),
+                                 random.Normal(cluster.y, options_.cluster_stddev)};
+            return MakeShape(random, center, random.Uniform(options_.min_size, options_.max_size));
+        }
+        case ShapeDistribution::Grid: {
+            const auto snap = [this](double v) {
+                const double step = options_.grid_step;
+                return options_.min_coord + std::round((v - options_.min_coord) / step) * step;
+            };
+            const Point2D corner{snap(random.Uniform(options_.min_coord, options_.max_coord)),
+                                 snap(random.Uniform(options_.min_coord, options_.max_coord))};
+            const auto cells = static_cast<double>(random.UniformInt(1, 3));
+            if (random.UniformInt(0, 1) == 0) {
+                return Rectangle{corner, cells * options_.grid_step, options_.grid_step};
+            }
+            return MakeShape(random, corner, cells * options_.grid_step / 2.0);
+        }
+        case ShapeDistribution::HeavyTailed: {
+            const Point2D center{random.Uniform(options_.min_coord, options_.max_coord),
+                                 random.Uniform(options_.min_coord, options_.max_coord)};
+            const double max_size = (options_.max_coord - options_.min_coord) / 2.0;
+            const double size = std::min(random.Pareto(options_.min_size, options_.pareto_alpha), max_size);
+            return MakeShape(random, center, size);
+        }
+        case ShapeDistribution::Degenerate: {
+            return MakeDegenerateShape(random);
+        }
+        }
+        return Circle{{0.0, 0.0}, options_.min_size};
+    }
+
+    std::vector<Shape> GenerateShapes(size_t count, size_t first_index = 0) const {
+        GEOMETRY_PROFILE_SCOPE("utils::CounterBasedShapeGenerator::GenerateShapes");
+
+        std::vector<Shape> shapes(count);
+        parallel::ForEachChunk(count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                shapes[i] = GenerateShape(first_index + i);
+            }
+        });
+        return shapes;
+    }
+
+private:
+    // номера независимых потоков Philox для одного и того же индекса
+    static constexpr uint32_t kShapeStream = 0;
+    static constexpr uint32_t kClusterStream = 1;
+
+    Point2D ClusterCenter(size_t cluster) const noexcept {
+        CounterRandom random{seed_, cluster, kClusterStream};
+        return {random.Uniform(options_.min_coord, options_.max_coord),
+                random.Uniform(options_.min_coord, options_.max_coord)};
+    }
+
+    static Shape MakeShape(CounterRandom &random, Point2D center, double size) {
+        switch (random.UniformInt(0, 4)) {
+        case 0:
+            return Line{center, {center.x + size, center.y + size}};
+        case 1:
+            return Triangle{center, {center.x + size, center.y}, {center.x + size / 2, center.y + size}};
+        case 2:
+            return Rectangle{center, size, size * 0.8};
+        case 3:
+            return RegularPolygon{center, size, random.UniformInt(3, 12)};
+        default:
+            return Circle{center, size};
+        }
+    }
+
+    Shape MakeDegenerateShape(CounterRandom &random) const {
+        // все вырожденные фигуры лежат на прямой y = x
+        const double t = random.Uniform(options_.min_coord, options_.max_coord);
+        const double size = random.Uniform(options_.min_size, options_.max_size);
+        const Point2D p{t, t};
+
+        switch (random.UniformInt(0, 4)) {
+        case 0:
+            return Line{p, p};
+        case 1:
+            return Triangle{p, {t + size, t + size}, {t + 2 * size, t + 2 * size}};
+        case 2:
+            return Rectangle{p, size, 0.0};
+        case 3:
+            return Polygon{{p, {t + size, t + size}}};
+        default:
+            return Circle{p, 0.0};
+        }
+    }
+
+    uint64_t seed_;
+    ShapeDistribution distribution_;
+    Options options_;
+};
+
+/*
+ * Пары фигур с пересекающимися ограничивающими объёмами
+ *
+ * BoundingVolume::Tightest сначала строит все объёмы фигур и дополнительно отсекает пары по окружностям
+ * и ориентированным прямоугольникам: кандидатов для точной проверки меньше, порядок пар тот же
+ */
+inline std::vector<std::pair<Shape, Shape>> FindAllCollisions(
+    std::span<const Shape> shapes, queries::BoundingVolume volume = queries::BoundingVolume::Box) {
+    GEOMETRY_PROFILE_SCOPE("utils::FindAllCollisions");
+    GEOMETRY_PROFILE_COUNT(CandidatePairs, shapes.size() * (shapes.size() - 1) / 2);
+
+    if (volume == queries::BoundingVolume::Tightest) {
+        const auto volumes = queries::GetBoundingVolumes(shapes);
+        std::vector<std::pair<Shape, Shape>> collisions;
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            for (size_t j = i + 1; j < shapes.size(); ++j) {
+                if (volumes[i].Overlaps(volumes[j])) {
+                    collisions.emplace_back(shapes[i], shapes[j]);
+                }
+            }
+        }
+        return collisions;
+    }
+
     // clang-format off
     auto collisions = std::views::cartesian_product(shapes, shapes) | 
                       std::views::filter([](const auto &t) {
@@ -82,6 +256,31 @@ inline std::vector<std::pair<Shape, Shape>> FindAllCollisions(std::span<const Sh
     return collisions;
 }
 
+/*
+ * Пары действительно пересекающихся фигур: широкая фаза по всем ограничивающим объёмам, затем точная
+ * проверка intersections::NarrowPhase. Порядок пар тот же, что у FindAllCollisions
+ */
+inline std::vector<std::pair<Shape, Shape>> FindAllOverlaps(std::span<const Shape> shapes) {
+    GEOMETRY_PROFILE_SCOPE("utils::FindAllOverlaps");
+    GEOMETRY_PROFILE_COUNT(CandidatePairs, shapes.size() * (shapes.size() - 1) / 2);
+
+    const auto volumes = queries::GetBoundingVolumes(shapes);
+    std::vector<intersections::ShapePair> candidates;
+    for (uint32_t i = 0; i < shapes.size(); ++i) {
+        for (uint32_t j = i + 1; j < shapes.size(); ++j) {
+            if (volumes[i].Overlaps(volumes[j])) {
+                candidates.emplace_back(i, j);
+            }
+        }
+    }
+
+    std::vector<std::pair<Shape, Shape>> overlaps;
+    for (const auto &[first, second] : intersections::NarrowPhase{shapes}.Filter(candidates)) {
+        overlaps.emplace_back(shapes[first], shapes[second]);
+    }
+    return overlaps;
+}
+
 inline std::optional<size_t> FindHighestShape(std::span<const Shape> shapes) {
     auto it = std::ranges::max_element(shapes, {}, &queries::GetHeight);
     if (it == shapes.end()) {
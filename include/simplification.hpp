@@ -0,0 +1,54 @@
+#pragma once
+#include "geometry.hpp"
+#include <span>
+#include <vector>
+
+namespace geometry::simplification {
+
+/*
+ * Упрощение ломаных и многоугольников с заданной точностью
+ *
+ * closed -- точки образуют кольцо (многоугольник, выпуклая оболочка из GrahamScan), иначе открытую ломаную,
+ * концы которой сохраняются. Результат -- подмножество исходных вершин в исходном порядке,
+ * поэтому упрощённая выпуклая оболочка остаётся выпуклой
+ */
+
+// Дуглас-Пекер с явным стеком: вершины дальше tolerance от упрощённой ломаной не удаляются
+std::vector<Point2D> DouglasPeucker(std::span<const Point2D> points, double tolerance, bool closed = true);
+
+// Висвалингам-Уайатт с кучей: удаляются вершины, образующие с соседями треугольник площади меньше min_area
+std::vector<Point2D> Visvalingam(std::span<const Point2D> points, double min_area, bool closed = true);
+
+Polygon Simplify(const Polygon &polygon, double tolerance);
+
+// пакетный режим: многоугольники упрощаются параллельно
+std::vector<Polygon> Simplify(std::span<const Polygon> polygons, double tolerance);
+
+/*
+ * Иерархия уровней детализации по Дугласу-Пекеру
+ *
+ * Для каждой вершины хранится наибольшая точность, при которой она ещё нужна; уровни вложены,
+ * и Level(tolerance) совпадает с DouglasPeucker(points, tolerance, closed); опорные вершины есть на любом
+ * уровне, в том числе при бесконечной tolerance. Построение O(n log n) в среднем, уровень из k вершин --
+ * O(k log k)
+ */
+class DetailHierarchy {
+public:
+    explicit DetailHierarchy(std::span<const Point2D> points, bool closed = true);
+
+    std::vector<Point2D> Level(double tolerance) const;
+
+    // число вершин уровня
+    size_t VerticesCount(double tolerance) const;
+
+    // наименьшая точность уровня, в котором не больше max_vertices вершин (но не меньше опорных)
+    double ToleranceFor(size_t max_vertices) const;
+
+private:
+    std::vector<Point2D> points_;
+    // номера вершин по убыванию значимости и сами значимости
+    std::vector<uint32_t> order_;
+    std::vector<double> significance_;
+};
+
+}  // namespace geometry::simplification
@@ -0,0 +1,190 @@
+#pragma once
+#include "geometry.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace geometry::spatial {
+
+// разрядность решётки по каждой координате для обеих кривых
+inline constexpr uint32_t kHilbertBits = 16;
+
+enum class Curve { Hilbert, Morton };
+
+namespace detail {
+
+/*
+ * Переходы кривой Гильберта по уровням: состояние -- обмен осей (бит 0) и отражение (бит 1),
+ * элемент [state * 4 + (bit_x << 1 | bit_y)] -- цифра квадранта (биты 2-3) и следующее состояние
+ */
+inline constexpr auto kHilbertTable = [] {
+    std::array<uint8_t, 16> table{};
+    for (uint32_t state = 0; state != 4; ++state) {
+        for (uint32_t bits = 0; bits != 4; ++bits) {
+            const uint32_t bx = bits >> 1;
+            const uint32_t by = bits & 1;
+            const uint32_t rx = ((state & 1) != 0 ? by : bx) ^ (state >> 1);
+            const uint32_t ry = ((state & 1) != 0 ? bx : by) ^ (state >> 1);
+            const uint32_t next = ry != 0 ? state : state ^ 1 ^ (rx << 1);
+            table[state * 4 + bits] = static_cast<uint8_t>(((3 * rx) ^ ry) << 2 | next);
+        }
+    }
+    return table;
+}();
+
+}  // namespace detail
+
+// номер клетки (x, y) решётки 2^kHilbertBits x 2^kHilbertBits вдоль кривой Гильберта, без ветвлений
+constexpr uint64_t HilbertIndex(uint32_t x, uint32_t y) noexcept {
+    uint64_t d = 0;
+    uint32_t state = 0;
+    for (uint32_t level = kHilbertBits; level-- > 0;) {
+        const uint8_t entry = detail::kHilbertTable[state * 4 + ((x >> level) & 1) * 2 + ((y >> level) & 1)];
+        d = d << 2 | entry >> 2;
+        state = entry & 3;
+    }
+    return d;
+}
+
+// чередование битов x и y (Z-порядок): дешевле HilbertIndex, но с разрывами на границах квадрантов
+constexpr uint64_t MortonIndex(uint32_t x, uint32_t y) noexcept {
+    constexpr auto spread = [](uint64_t v) {
+        v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+        v = (v | (v << 8)) & 0x00ff00ff00ff00ffull;
+        v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0full;
+        v = (v | (v << 2)) & 0x3333333333333333ull;
+        v = (v | (v << 1)) & 0x5555555555555555ull;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+namespace detail {
+
+using SortKey = std::pair<uint64_t, uint32_t>;
+
+/*
+ * Поразрядная LSD-сортировка пар (ключ, номер) по байтам ключа, устойчивая
+ *
+ * Гистограммы всех байтов строятся за один проход; байты, одинаковые у всех ключей, пропускаются,
+ * поэтому 32-битные ключи кривых сортируются за 4 прохода
+ */
+inline void RadixSort(std::vector<SortKey> &keys) {
+    std::array<std::array<size_t, 256>, sizeof(uint64_t)> counts{};
+    for (const auto &[key, _] : keys) {
+        for (size_t digit = 0; digit != counts.size(); ++digit) {
+            ++counts[digit][(key >> (8 * digit)) & 0xff];
+        }
+    }
+
+    std::vector<SortKey> buffer(keys.size());
+    for (size_t digit = 0; digit != counts.size(); ++digit) {
+        auto &offsets = counts[digit];
+        if (std::ranges::find(offsets, keys.size()) != offsets.end()) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto &count : offsets) {
+            offset += std::exchange(count, offset);
+        }
+        for (const auto &key : keys) {
+            buffer[offsets[(key.first >> (8 * digit)) & 0xff]++] = key;
+        }
+        keys.swap(buffer);
+    }
+}
+
+// ключи кривой в квадрате, охватывающем точки
+inline std::vector<SortKey> CurveKeys(std::span<const Point2D> points, Curve curve) {
+    std::vector<SortKey> keys(points.size());
+    if (points.empty()) {
+        return keys;
+    }
+
+    const auto [min_x, max_x] = std::ranges::minmax(points, {}, &Point2D::x);
+    const auto [min_y, max_y] = std::ranges::minmax(points, {}, &Point2D::y);
+    const double extent = std::max(max_x.x - min_x.x, max_y.y - min_y.y);
+    const double scale = extent > 0 ? ((1u << kHilbertBits) - 1) / extent : 0.0;
+
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        const auto x = static_cast<uint32_t>((points[i].x - min_x.x) * scale);
+        const auto y = static_cast<uint32_t>((points[i].y - min_y.y) * scale);
+        keys[i] = {curve == Curve::Hilbert ? HilbertIndex(x, y) : MortonIndex(x, y), i};
+    }
+    return keys;
+}
+
+inline std::vector<uint32_t> SortedIndices(std::vector<SortKey> &keys) {
+    RadixSort(keys);
+
+    std::vector<uint32_t> order(keys.size());
+    for (size_t i = 0; i != keys.size(); ++i) {
+        order[i] = keys[i].second;
+    }
+    return order;
+}
+
+}  // namespace detail
+
+/*
+ * Перестановка точек вдоль кривой в охватывающем их прямоугольнике
+ *
+ * Соседние по порядку точки близки на плоскости, поэтому обход в этом порядке сохраняет локальность
+ * (короткие шаги при поиске, попадания в кэш). Равные ключи сохраняют исходный порядок
+ */
+inline std::vector<uint32_t> CurveOrder(std::span<const Point2D> points, Curve curve = Curve::Hilbert) {
+    auto keys = detail::CurveKeys(points, curve);
+    return detail::SortedIndices(keys);
+}
+
+inline std::vector<uint32_t> HilbertOrder(std::span<const Point2D> points) {
+    return CurveOrder(points, Curve::Hilbert);
+}
+
+// фигуры упорядочиваются по центрам охватывающих прямоугольников
+inline std::vector<uint32_t> CurveOrder(std::span<const Shape> shapes, Curve curve = Curve::Hilbert) {
+    std::vector<Point2D> centers(shapes.size());
+    std::ranges::transform(shapes, centers.begin(), [](const Shape &shape) {
+        return std::visit([](const auto &s) { return s.BoundBox(); }, shape).Center();
+    });
+    return CurveOrder(centers, curve);
+}
+
+/*
+ * Смещённый случайный порядок вставки (BRIO) для инкрементных триангуляций
+ *
+ * Точка попадает в последний раунд с вероятностью 1/2, в предпоследний -- 1/4 и т.д., раунды идут
+ * от меньшего к большему, внутри раунда -- вдоль кривой Гильберта. Случайность раундов сохраняет
+ * ожидаемую сложность случайной вставки, а порядок внутри раунда делает поиск коротким
+ */
+inline std::vector<uint32_t> BrioOrder(std::span<const Point2D> points, uint32_t seed = 20) {
+    auto keys = detail::CurveKeys(points, Curve::Hilbert);
+
+    std::mt19937 gen(seed);
+    const auto last_round = static_cast<uint32_t>(std::bit_width(points.size()));
+    for (auto &[key, _] : keys) {
+        const auto round = last_round - std::min<uint32_t>(std::countr_zero(gen()), last_round);
+        key |= uint64_t{round} << (2 * kHilbertBits);
+    }
+    return detail::SortedIndices(keys);
+}
+
+// items, переставленные в порядке order
+template <typename T>
+std::vector<T> ApplyOrder(std::span<const T> items, std::span<const uint32_t> order) {
+    std::vector<T> res;
+    res.reserve(order.size());
+    for (const uint32_t i : order) {
+        res.push_back(items[i]);
+    }
+    return res;
+}
+
+}  // namespace geometry::spatial
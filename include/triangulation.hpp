@@ -1,55 +1,66 @@
 #pragma once
 #include "convex_hull.hpp"
 #include "geometry.hpp"
+#include "profiling.hpp"
+#include "vertex_welding.hpp"
 #include <algorithm>
+#include <array>
 #include <cassert>
-#include <flat_map>
+#include <iterator>
+#include <memory_resource>
 #include <vector>
 
 namespace geometry::triangulation {
 
-struct DelaunayTriangle {
-    Point2D a, b, c;
+template <Scalar T>
+struct BasicDelaunayTriangle {
+    using Point = BasicPoint2D<T>;
 
-    DelaunayTriangle() {}
-    DelaunayTriangle(Point2D a, Point2D b, Point2D c) : a(a), b(b), c(c) {}
+    // допуск вырожденности и совпадения вершин, на порядок строже допуска are_equals
+    static constexpr T kTolerance = ScalarTraits<T>::kEpsilon / T{10};
 
-    bool ContainsPoint(const Point2D &p) const {
-        Point2D center = Circumcenter();
-        double radius = Circumradius();
-        return center.DistanceTo(p) <= radius + 1e-10;
+    Point a, b, c;
+
+    BasicDelaunayTriangle() {}
+    BasicDelaunayTriangle(Point a, Point b, Point c) : a(a), b(b), c(c) {}
+
+    bool ContainsPoint(const Point &p) const {
+        Point center = Circumcenter();
+        T radius = Circumradius();
+        return center.DistanceTo(p) <= radius + kTolerance;
     }
 
-    Point2D Circumcenter() const {
-        double d = 2 * (a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y));
-        if (std::abs(d) < 1e-10) {
+    Point Circumcenter() const {
+        T d = 2 * (a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y));
+        if (std::abs(d) < kTolerance) {
             return {(a.x + b.x + c.x) / 3, (a.y + b.y + c.y) / 3};
         }
 
-        double ux = ((a.x * a.x + a.y * a.y) * (b.y - c.y) + (b.x * b.x + b.y * b.y) * (c.y - a.y) +
-                     (c.x * c.x + c.y * c.y) * (a.y - b.y)) /
-                    d;
+        T ux = ((a.x * a.x + a.y * a.y) * (b.y - c.y) + (b.x * b.x + b.y * b.y) * (c.y - a.y) +
+                (c.x * c.x + c.y * c.y) * (a.y - b.y)) /
+               d;
 
-        double uy = ((a.x * a.x + a.y * a.y) * (c.x - b.x) + (b.x * b.x + b.y * b.y) * (a.x - c.x) +
-                     (c.x * c.x + c.y * c.y) * (b.x - a.x)) /
-                    d;
+        T uy = ((a.x * a.x + a.y * a.y) * (c.x - b.x) + (b.x * b.x + b.y * b.y) * (a.x - c.x) +
+                (c.x * c.x + c.y * c.y) * (b.x - a.x)) /
+               d;
 
         return {ux, uy};
     }
 
-    double Circumradius() const {
-        Point2D center = Circumcenter();
+    T Circumradius() const {
+        Point center = Circumcenter();
         return center.DistanceTo(a);
     }
 
-    bool SharesEdge(const DelaunayTriangle &other) const {
-        std::vector<Point2D> this_points = {a, b, c};
-        std::vector<Point2D> other_points = {other.a, other.b, other.c};
+    bool SharesEdge(const BasicDelaunayTriangle &other) const {
+        // без промежуточных векторов: вершин всего по три
+        const std::array<Point, 3> this_points = {a, b, c};
+        const std::array<Point, 3> other_points = {other.a, other.b, other.c};
 
         int shared_count = 0;
-        for (const Point2D &p1 : this_points) {
-            for (const Point2D &p2 : other_points) {
-                if (std::abs(p1.x - p2.x) < 1e-10 && std::abs(p1.y - p2.y) < 1e-10) {
+        for (const Point &p1 : this_points) {
+            for (const Point &p2 : other_points) {
+                if (std::abs(p1.x - p2.x) < kTolerance && std::abs(p1.y - p2.y) < kTolerance) {
                     shared_count++;
                     break;
                 }
@@ -59,54 +70,77 @@ struct DelaunayTriangle {
         return shared_count == 2;
     }
 
-    bool operator==(const DelaunayTriangle &other) const noexcept {
+    bool operator==(const BasicDelaunayTriangle &other) const noexcept {
         return std::tie(a, b, c) == std::tie(other.a, other.b, other.c);
     };
 
-    std::vector<Point2D> vertices() const { return {a, b, c}; }
+    std::vector<Point> vertices() const { return {a, b, c}; }
 };
 
-struct Edge {
-    Point2D p1, p2;
+using DelaunayTriangle = BasicDelaunayTriangle<double>;
+
+template <Scalar T>
+struct BasicEdge {
+    using Point = BasicPoint2D<T>;
+
+    static constexpr T kTolerance = BasicDelaunayTriangle<T>::kTolerance;
+
+    Point p1, p2;
 
-    Edge(Point2D p1, Point2D p2) : p1(p1), p2(p2) {
+    BasicEdge(Point p1, Point p2) : p1(p1), p2(p2) {
         if (p1.x > p2.x || (p1.x == p2.x && p1.y > p2.y)) {
             std::swap(this->p1, this->p2);
         }
     }
 
-    bool operator<(const Edge &other) const {
-        if (std::abs(p1.x - other.p1.x) > 1e-10)
+    bool operator<(const BasicEdge &other) const {
+        if (std::abs(p1.x - other.p1.x) > kTolerance)
             return p1.x < other.p1.x;
-        if (std::abs(p1.y - other.p1.y) > 1e-10)
+        if (std::abs(p1.y - other.p1.y) > kTolerance)
             return p1.y < other.p1.y;
-        if (std::abs(p2.x - other.p2.x) > 1e-10)
+        if (std::abs(p2.x - other.p2.x) > kTolerance)
             return p2.x < other.p2.x;
         return p2.y < other.p2.y;
     }
 
-    bool operator==(const Edge &other) const {
-        return std::abs(p1.x - other.p1.x) < 1e-10 && std::abs(p1.y - other.p1.y) < 1e-10 &&
-               std::abs(p2.x - other.p2.x) < 1e-10 && std::abs(p2.y - other.p2.y) < 1e-10;
+    bool operator==(const BasicEdge &other) const {
+        return std::abs(p1.x - other.p1.x) < kTolerance && std::abs(p1.y - other.p1.y) < kTolerance &&
+               std::abs(p2.x - other.p2.x) < kTolerance && std::abs(p2.y - other.p2.y) < kTolerance;
     }
 };
 
-inline GeometryResult<std::vector<DelaunayTriangle>> DelaunayTriangulation(std::span<const Point2D> points) {
+using Edge = BasicEdge<double>;
+
+namespace detail {
+
+/*
+ * Vector -- тип результата, scratch -- ресурс для временных буферов (оболочка, плохие треугольники, рёбра)
+ */
+template <typename Vector>
+GeometryResult<Vector> DelaunayTriangulationImpl(std::span<const typename Vector::value_type::Point> points,
+                                                 std::pmr::memory_resource *scratch,
+                                                 const typename Vector::allocator_type &alloc) {
+    using Triangle = typename Vector::value_type;
+    using Point = typename Triangle::Point;
+    using T = typename Point::value_type;
+
+    GEOMETRY_PROFILE_SCOPE("triangulation::DelaunayTriangulation");
 
     if (points.size() < 3) {
         return std::unexpected(GeometryError::InsufficientPoints);
     }
 
-    std::vector<DelaunayTriangle> triangulation;
+    Vector triangulation(alloc);
 
     // большой треугольник, содержащий все точки
-    DelaunayTriangle super_triangle{};
+    Triangle super_triangle{};
     {
-        auto hull = convex_hull::GrahamScan(points);
+        auto hull = convex_hull::GrahamScan(points, scratch);
         assert(hull.has_value());
 
-        const auto poly_hull = Polygon(std::move(*hull));
-        const auto bb_hull = poly_hull.BoundBox();
+        const auto [min_x, max_x] = std::ranges::minmax(*hull, {}, &Point::x);
+        const auto [min_y, max_y] = std::ranges::minmax(*hull, {}, &Point::y);
+        const BasicBoundingBox<T> bb_hull{min_x.x, min_y.y, max_x.x, max_y.y};
         const auto bb_center = bb_hull.Center();
 
         // радиус окружности вписанной в правильный треугольник = (a * sqrt(3)) / 6
@@ -116,65 +150,126 @@ inline GeometryResult<std::vector<DelaunayTriangle>> DelaunayTriangulation(std::
         const auto r_out = 2. * r_in;
 
         // треугольник в описанной около него окружности
-        const auto rp_three_sides = RegularPolygon(bb_center, r_out, 3);
-        const auto vts = rp_three_sides.Vertices();
-        triangulation.emplace_back(vts[0], vts[1], vts[2]);
-        std::tie(super_triangle.a, super_triangle.b, super_triangle.c) = std::tie(vts[0], vts[1], vts[2]);
+        const auto rp_three_sides = RegularPolygon(static_cast<Point2D>(bb_center), r_out, 3);
+        super_triangle = {static_cast<Point>(rp_three_sides.Vertex(0)), static_cast<Point>(rp_three_sides.Vertex(1)),
+                          static_cast<Point>(rp_three_sides.Vertex(2))};
+        triangulation.push_back(super_triangle);
     }
 
-    for (const Point2D &point : points) {
+    // вершины сварены в целые номера, 0..2 -- вершины большого треугольника; номера треугольника лежат
+    // в vertex_ids под тем же индексом, что и сам треугольник
+    spatial::BasicVertexWelder<T> welder(Triangle::kTolerance, points.size() + 3, scratch);
+    std::pmr::vector<std::array<uint32_t, 3>> vertex_ids(scratch);
+    vertex_ids.push_back({welder.Weld(super_triangle.a), welder.Weld(super_triangle.b), welder.Weld(super_triangle.c)});
+
+    // сохраняет треугольники, для которых keep(i) истинно, не меняя их порядка
+    auto compact = [&](auto keep) {
+        size_t kept = 0;
+        for (size_t i = 0; i != triangulation.size(); ++i) {
+            if (keep(i)) {
+                triangulation[kept] = triangulation[i];
+                vertex_ids[kept] = vertex_ids[i];
+                ++kept;
+            }
+        }
+        triangulation.erase(triangulation.begin() + kept, triangulation.end());
+        vertex_ids.resize(kept);
+    };
+
+    // буферы переиспользуются между вставками, чтобы не аллоцировать память на каждую точку
+    std::pmr::vector<uint64_t> edges(scratch);
+    std::pmr::vector<std::array<uint32_t, 2>> hole_edges(scratch);
 
-        auto bad_triangles =
-            triangulation |
-            std::views::filter([&point](const auto &triangle) { return triangle.ContainsPoint(point); }) |
-            std::ranges::to<std::vector>();
-        if (bad_triangles.empty()) {
+    for (const Point &point : points) {
+        GEOMETRY_PROFILE_COUNT(TrianglesVisited, triangulation.size());
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, triangulation.size());
+
+        // повтор уже вставленной точки триангуляцию не меняет
+        if (welder.Find(point) != welder.kNoVertex) {
             continue;
         }
 
-        // поиск общих ребер
-        std::flat_map<Edge, int> counting_edges;
-        for (const auto &triangle : bad_triangles) {
-            auto vts = triangle.vertices();
-            ++counting_edges[Edge(vts[0], vts[1])];
-            ++counting_edges[Edge(vts[1], vts[2])];
-            ++counting_edges[Edge(vts[2], vts[0])];
+        // рёбра треугольников с точкой внутри описанной окружности; сами треугольники удаляются
+        edges.clear();
+        compact([&](size_t i) {
+            if (!triangulation[i].ContainsPoint(point)) {
+                return true;
+            }
+            const auto &[a, b, c] = vertex_ids[i];
+            edges.push_back(welder.EdgeKey(a, b));
+            edges.push_back(welder.EdgeKey(b, c));
+            edges.push_back(welder.EdgeKey(c, a));
+            return false;
+        });
+        // вершина регистрируется только для действительно вставленной точки
+        if (edges.empty()) {
+            continue;
+        }
+        const uint32_t id = welder.Weld(point);
+
+        // ребра-границы "дырки" встречаются один раз
+        std::ranges::sort(edges);
+        hole_edges.clear();
+        for (size_t i = 0; i != edges.size(); ++i) {
+            if ((i == 0 || edges[i - 1] != edges[i]) && (i + 1 == edges.size() || edges[i + 1] != edges[i])) {
+                auto a = static_cast<uint32_t>(edges[i] >> 32);
+                auto b = static_cast<uint32_t>(edges[i]);
+                if (welder.Vertex(b) < welder.Vertex(a)) {
+                    std::swap(a, b);
+                }
+                hole_edges.push_back({a, b});
+            }
         }
 
-        // удаление из триангуляции всех треугольников с точками внутри
-        std::erase_if(triangulation, [&bad_triangles](const DelaunayTriangle &triangle) {
-            return std::ranges::any_of(bad_triangles, [&](const DelaunayTriangle &bad_triangle) {
-                return std::tie(triangle.a, triangle.b, triangle.c) ==
-                       std::tie(bad_triangle.a, bad_triangle.b, bad_triangle.c);
-            });
+        // порядок по координатам концов, как у Edge: результат не зависит от нумерации вершин
+        std::ranges::sort(hole_edges, [&welder](const auto &lhs, const auto &rhs) {
+            return std::pair{welder.Vertex(lhs[0]), welder.Vertex(lhs[1])} <
+                   std::pair{welder.Vertex(rhs[0]), welder.Vertex(rhs[1])};
         });
-
-        // ребра-границы "дырки" -- одно общее ребро
-        auto hole_edges =
-            counting_edges | std::views::filter([](const auto &pair) { return pair.second == 1; }) | std::views::keys;
-
-        for (const auto &edge : hole_edges) {
-            triangulation.emplace_back(edge.p1, edge.p2, point);
+        for (const auto &[a, b] : hole_edges) {
+            triangulation.emplace_back(welder.Vertex(a), welder.Vertex(b), point);
+            vertex_ids.push_back({a, b, id});
         }
     }
 
-    std::erase_if(triangulation, [&super_triangle](const DelaunayTriangle &tri) {
-        auto has_super_vertex = [&super_triangle](const Point2D &v) {
-            return v == super_triangle.a || v == super_triangle.b || v == super_triangle.c;
-        };
-        return has_super_vertex(tri.a) || has_super_vertex(tri.b) || has_super_vertex(tri.c);
-    });
+    compact([&vertex_ids](size_t i) { return std::ranges::all_of(vertex_ids[i], [](uint32_t v) { return v > 2; }); });
 
     return triangulation;
 }
+
+}  // namespace detail
+
+inline GeometryResult<std::vector<DelaunayTriangle>> DelaunayTriangulation(std::span<const Point2D> points) {
+    return detail::DelaunayTriangulationImpl<std::vector<DelaunayTriangle>>(points, std::pmr::get_default_resource(),
+                                                                            {});
+}
+
+inline GeometryResult<std::vector<BasicDelaunayTriangle<float>>>
+DelaunayTriangulation(std::span<const Point2Df> points) {
+    return detail::DelaunayTriangulationImpl<std::vector<BasicDelaunayTriangle<float>>>(
+        points, std::pmr::get_default_resource(), {});
+}
+
+// Результат и все временные буферы размещаются в resource (например, в ScratchArena)
+inline GeometryResult<std::pmr::vector<DelaunayTriangle>> DelaunayTriangulation(std::span<const Point2D> points,
+                                                                                std::pmr::memory_resource *resource) {
+    return detail::DelaunayTriangulationImpl<std::pmr::vector<DelaunayTriangle>>(points, resource, resource);
+}
+
+inline GeometryResult<std::pmr::vector<BasicDelaunayTriangle<float>>>
+DelaunayTriangulation(std::span<const Point2Df> points, std::pmr::memory_resource *resource) {
+    return detail::DelaunayTriangulationImpl<std::pmr::vector<BasicDelaunayTriangle<float>>>(points, resource,
+                                                                                              resource);
+}
+
 }  // namespace geometry::triangulation
 
-template <>
-struct std::formatter<geometry::triangulation::DelaunayTriangle> {
+template <geometry::Scalar T>
+struct std::formatter<geometry::triangulation::BasicDelaunayTriangle<T>> {
     constexpr auto parse(std::format_parse_context &ctx) { return ctx.begin(); }
 
     template <typename FormatContext>
-    auto format(const geometry::triangulation::DelaunayTriangle &t, FormatContext &ctx) const {
+    auto format(const geometry::triangulation::BasicDelaunayTriangle<T> &t, FormatContext &ctx) const {
         return std::format_to(ctx.out(), "DelaunayTriangle({}, {}, {})", t.a, t.b, t.c);
     }
 };
@@ -0,0 +1,144 @@
+#pragma once
+#include "geometry.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace geometry::spatial {
+
+/*
+ * Сварка вершин: точки, совпадающие с точностью tolerance по каждой координате, получают один
+ * целый номер
+ *
+ * Координаты привязываются к решётке с шагом 2 * tolerance, клетки лежат в хеш-таблице с открытой адресацией
+ * (линейное пробирование, заполнение не больше половины). Совпадающая вершина может лежать только в клетке
+ * точки и трёх соседних со стороны ближайшего угла, поэтому сварка и поиск стоят O(1), а рёбра и общие
+ * вершины сравниваются как целые числа
+ */
+template <Scalar T>
+class BasicVertexWelder {
+public:
+    using Point = BasicPoint2D<T>;
+
+    static constexpr uint32_t kNoVertex = ~uint32_t{0};
+
+    explicit BasicVertexWelder(T tolerance, size_t expected_vertices = 0,
+                               std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : tolerance_{tolerance}, vertices_{resource}, slots_{resource} {
+        vertices_.reserve(expected_vertices);
+        slots_.resize(std::bit_ceil(std::max<size_t>(16, 2 * expected_vertices)));
+    }
+
+    // номер вершины, совпадающей с p; если такой нет, p становится новой вершиной
+    uint32_t Weld(Point p) {
+        if (const uint32_t id = Find(p); id != kNoVertex) {
+            return id;
+        }
+
+        if (2 * (vertices_.size() + 1) > slots_.size()) {
+            Grow();
+        }
+        const auto id = static_cast<uint32_t>(vertices_.size());
+        vertices_.push_back(p);
+        Insert({CellOf(p.x / (2 * tolerance_)), CellOf(p.y / (2 * tolerance_)), id});
+        return id;
+    }
+
+    // kNoVertex, если совпадающей вершины нет
+    uint32_t Find(Point p) const noexcept {
+        const double x = p.x / (2 * tolerance_);
+        const double y = p.y / (2 * tolerance_);
+        const double cx = CellOf(x);
+        const double cy = CellOf(y);
+
+        // окрестность p шириной 2 * tolerance задевает только соседей со стороны ближайших границ клетки
+        const double nx = x - cx < 0.5 ? cx - 1 : cx + 1;
+        const double ny = y - cy < 0.5 ? cy - 1 : cy + 1;
+        for (const auto &[ix, iy] : {std::pair{cx, cy}, std::pair{nx, cy}, std::pair{cx, ny}, std::pair{nx, ny}}) {
+            if (const uint32_t id = FindInCell(ix, iy, p); id != kNoVertex) {
+                return id;
+            }
+        }
+        return kNoVertex;
+    }
+
+    Point Vertex(uint32_t id) const noexcept { return vertices_[id]; }
+    std::span<const Point> Vertices() const noexcept { return vertices_; }
+    size_t Size() const noexcept { return vertices_.size(); }
+
+    // ключ ребра, не зависящий от направления
+    static constexpr uint64_t EdgeKey(uint32_t a, uint32_t b) noexcept {
+        return a < b ? uint64_t{a} << 32 | b : uint64_t{b} << 32 | a;
+    }
+
+private:
+    struct Slot {
+        double x = 0;
+        double y = 0;
+        uint32_t id = kNoVertex;
+    };
+
+    /*
+     * scaled -- координата в долях клетки; номер клетки остаётся double без ограничения диапазона, в хеш
+     * идёт его битовое представление (+ 0.0 сводит -0 к 0). Начиная с 2^53 соседние double отстоят больше
+     * чем на tolerance, и cx +- 1 == cx ничего не теряет: совпасть могут только равные координаты
+     */
+    static double CellOf(double scaled) noexcept { return std::floor(scaled) + 0.0; }
+
+    size_t SlotOf(double cx, double cy) const noexcept {
+        // у целых double младшие биты мантиссы нулевые, поэтому старшая половина сначала сворачивается в младшую
+        constexpr auto fold = [](double v) {
+            const auto bits = std::bit_cast<uint64_t>(v);
+            return bits ^ (bits >> 32);
+        };
+        uint64_t h = fold(cx) * 0x9e3779b97f4a7c15ull;
+        h ^= fold(cy) * 0xc2b2ae3d27d4eb4full;
+        h ^= h >> 32;
+        return static_cast<size_t>(h) & (slots_.size() - 1);
+    }
+
+    // в одной клетке может быть несколько вершин, удалённых друг от друга больше чем на tolerance
+    uint32_t FindInCell(double cx, double cy, Point p) const noexcept {
+        for (size_t i = SlotOf(cx, cy); slots_[i].id != kNoVertex; i = (i + 1) & (slots_.size() - 1)) {
+            const Slot &slot = slots_[i];
+            if (slot.x == cx && slot.y == cy) {
+                const Point &v = vertices_[slot.id];
+                if (std::abs(v.x - p.x) < tolerance_ && std::abs(v.y - p.y) < tolerance_) {
+                    return slot.id;
+                }
+            }
+        }
+        return kNoVertex;
+    }
+
+    void Insert(const Slot &slot) noexcept {
+        size_t i = SlotOf(slot.x, slot.y);
+        while (slots_[i].id != kNoVertex) {
+            i = (i + 1) & (slots_.size() - 1);
+        }
+        slots_[i] = slot;
+    }
+
+    void Grow() {
+        std::pmr::vector<Slot> old(2 * slots_.size(), slots_.get_allocator());
+        old.swap(slots_);
+        for (const Slot &slot : old) {
+            if (slot.id != kNoVertex) {
+                Insert(slot);
+            }
+        }
+    }
+
+    T tolerance_;
+    std::pmr::vector<Point> vertices_;
+    std::pmr::vector<Slot> slots_;
+};
+
+using VertexWelder = BasicVertexWelder<double>;
+
+}  // namespace geometry::spatial
@@ -1,13 +1,27 @@
 #pragma once
 
 #include "geometry.hpp"
+#include "plot_batch.hpp"
 #include "triangulation.hpp"
 #include <span>
 
 namespace geometry::visualization {
 
+struct DrawOptions {
+    // одна серия на тип фигуры вместо отдельного plot() на каждую фигуру
+    bool batched = true;
+    // упрощение в экранных пикселях: сегменты окружностей и схлопывание мелких фигур в точки
+    bool level_of_detail = true;
+    // сторона окна в пикселях
+    size_t figure_size = 900;
+    // не больше стольких подписей с номерами; 0 -- без подписей
+    size_t max_labels = 200;
+};
+
 void Draw(std::span<const geometry::Shape> shapes);
+void Draw(std::span<const geometry::Shape> shapes, const DrawOptions &options);
 
 void Draw(std::span<const geometry::triangulation::DelaunayTriangle> triangles);
+void Draw(std::span<const geometry::triangulation::DelaunayTriangle> triangles, const DrawOptions &options);
 
 }  // namespace geometry::visualization
@@ -0,0 +1,46 @@
+#pragma once
+#include "geometry.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace geometry::voronoi {
+
+/*
+ * Ячейки диаграммы Вороного, обрезанные прямоугольником
+ *
+ * Вершины всех ячеек лежат подряд в одном массиве: ячейка сайта i -- vertices[offsets[i], offsets[i + 1])
+ * против часовой стрелки. Ячейка пуста, если область сайта не пересекает прямоугольник.
+ * Совпадающие сайты получают одинаковые ячейки
+ */
+struct VoronoiDiagram {
+    std::vector<Point2D> vertices;
+    std::vector<uint32_t> offsets;
+
+    size_t CellsCount() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    std::span<const Point2D> Cell(size_t site) const noexcept {
+        return std::span{vertices}.subspan(offsets[site], offsets[site + 1] - offsets[site]);
+    }
+
+    Polygon CellPolygon(size_t site) const {
+        const auto cell = Cell(site);
+        return Polygon{{cell.begin(), cell.end()}};
+    }
+};
+
+/*
+ * Диаграмма Вороного заметающей прямой Fortune за O(n log n)
+ *
+ * Береговая линия -- декартово дерево дуг с узлами из пула, события окружностей -- двоичная куча
+ * с ленивой отменой. Заметание даёт пары соседних сайтов, после чего каждая ячейка получается
+ * отсечением box полуплоскостями соседей
+ */
+GeometryResult<VoronoiDiagram> FortuneVoronoi(std::span<const Point2D> sites, const BoundingBox &box);
+
+// Береговая линия, очередь событий и промежуточные буферы размещаются в resource (например, в ScratchArena)
+GeometryResult<VoronoiDiagram> FortuneVoronoi(std::span<const Point2D> sites, const BoundingBox &box,
+                                              std::pmr::memory_resource *resource);
+
+}  // namespace geometry::voronoi
@@ -0,0 +1,193 @@
+#include "bounding_volumes.hpp"
+#include "convex_hull.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include "queries.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <random>
+
+namespace geometry::queries {
+
+namespace {
+
+// запас на ошибки округления при проверке точки
+bool Encloses(const Circle &circle, Point2D p) {
+    return p.DistanceTo(circle.center_p) <= circle.radius * (1 + 1e-12) + 1e-12;
+}
+
+Circle Diametral(Point2D a, Point2D b) { return {(a + b) / 2.0, a.DistanceTo(b) / 2}; }
+
+// окружность через три точки; у коллинеарных -- по самой далёкой паре
+Circle Circumscribed(Point2D a, Point2D b, Point2D c) {
+    const Point2D ab = b - a;
+    const Point2D ac = c - a;
+    const double d = 2 * ab.Cross(ac);
+    if (d == 0) {
+        const Circle candidates[] = {Diametral(a, b), Diametral(a, c), Diametral(b, c)};
+        return *std::ranges::max_element(candidates, {}, &Circle::radius);
+    }
+
+    const double ab2 = ab.Dot(ab);
+    const double ac2 = ac.Dot(ac);
+    const Point2D center{(ac.y * ab2 - ab.y * ac2) / d, (ab.x * ac2 - ac.x * ab2) / d};
+    return {a + center, center.Length()};
+}
+
+/*
+ * Итеративный Welzl: при нарушении точка i лежит на границе ответа для префикса, затем пара (i, j),
+ * затем тройка. На случайном порядке внутренние циклы запускаются редко
+ */
+Circle Welzl(std::vector<Point2D> points, uint32_t seed) {
+    // генератор с маленьким состоянием: BoundingCircle вызывается для каждой фигуры
+    std::minstd_rand gen(seed);
+    std::ranges::shuffle(points, gen);
+
+    Circle res{points[0], 0};
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (Encloses(res, points[i])) {
+            continue;
+        }
+        res = {points[i], 0};
+        for (size_t j = 0; j != i; ++j) {
+            if (Encloses(res, points[j])) {
+                continue;
+            }
+            res = Diametral(points[i], points[j]);
+            for (size_t k = 0; k != j; ++k) {
+                GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+                if (!Encloses(res, points[k])) {
+                    res = Circumscribed(points[i], points[j], points[k]);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+template <typename F>
+void ForEachOutlinePoint(const Shape &shape, ChordTolerance tolerance, F &&f) {
+    std::visit(
+        [&]<typename T>(const T &s) {
+            if constexpr (std::is_same_v<T, Circle>) {
+                // вершины описанного многоугольника: окружность целиком внутри него
+                const size_t n = s.Segments(tolerance);
+                const double radius = std::abs(s.radius) / std::cos(std::numbers::pi / static_cast<double>(n));
+                for (size_t i = 0; i != n; ++i) {
+                    const double angle = 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(n);
+                    f(Point2D{s.center_p.x + radius * std::cos(angle), s.center_p.y + radius * std::sin(angle)});
+                }
+            } else if constexpr (std::is_same_v<T, Polygon>) {
+                std::ranges::for_each(s.Points(), f);
+            } else {
+                std::ranges::for_each(s.Vertices(), f);
+            }
+        },
+        shape);
+}
+
+convex_hull::OrientedBox AxisAligned(const BoundingBox &box) {
+    return {box.Center(), {1., 0.}, box.Width() / 2, box.Height() / 2};
+}
+
+// прямоугольник наименьшей площади по выпуклой оболочке; вырожденные наборы -- по крайним точкам
+convex_hull::OrientedBox MinAreaBox(std::span<const Point2D> points) {
+    if (points.empty()) {
+        return {};
+    }
+    if (const auto hull = convex_hull::GrahamScan(points)) {
+        return convex_hull::MinAreaRectangle(*hull).value();
+    }
+    const auto [lo, hi] = std::ranges::minmax(points, std::less<>{});
+    const Point2D segment[] = {lo, hi};
+    return convex_hull::MinAreaRectangle(segment).value();
+}
+
+}  // namespace
+
+GeometryResult<Circle> MinEnclosingCircle(std::span<const Point2D> points, uint32_t seed) {
+    GEOMETRY_PROFILE_SCOPE("queries::MinEnclosingCircle");
+
+    if (points.empty()) {
+        return std::unexpected{GeometryError::InsufficientPoints};
+    }
+    return Welzl({points.begin(), points.end()}, seed);
+}
+
+GeometryResult<Circle> MinEnclosingCircle(std::span<const Shape> shapes, ChordTolerance tolerance) {
+    std::vector<Point2D> points;
+    for (const auto &shape : shapes) {
+        ForEachOutlinePoint(shape, tolerance, [&points](Point2D p) { points.push_back(p); });
+    }
+    return MinEnclosingCircle(points);
+}
+
+Circle BoundingCircle(const Shape &shape) {
+    return std::visit(
+        []<typename T>(const T &s) -> Circle {
+            if constexpr (std::is_same_v<T, Line>) {
+                return Diametral(s.start, s.end);
+            } else if constexpr (std::is_same_v<T, Triangle>) {
+                return Welzl({s.a, s.b, s.c}, 20);
+            } else if constexpr (std::is_same_v<T, Rectangle>) {
+                const auto box = s.BoundBox();
+                return Diametral({box.min_x, box.min_y}, {box.max_x, box.max_y});
+            } else if constexpr (std::is_same_v<T, RegularPolygon> || std::is_same_v<T, Circle>) {
+                return {s.center_p, std::abs(s.radius)};
+            } else {
+                return s.Points().empty() ? Circle{{0., 0.}, 0.} : MinEnclosingCircle(s.Points()).value();
+            }
+        },
+        shape);
+}
+
+convex_hull::OrientedBox BoundingOrientedBox(const Shape &shape) {
+    return std::visit(
+        []<typename T>(const T &s) -> convex_hull::OrientedBox {
+            if constexpr (std::is_same_v<T, Line>) {
+                const Point2D segment[] = {s.start, s.end};
+                return convex_hull::MinAreaRectangle(segment).value();
+            } else if constexpr (std::is_same_v<T, Triangle>) {
+                return convex_hull::MinAreaRectangle(s.Vertices()).value();
+            } else if constexpr (std::is_same_v<T, Rectangle> || std::is_same_v<T, Circle>) {
+                return AxisAligned(s.BoundBox());
+            } else if constexpr (std::is_same_v<T, RegularPolygon>) {
+                // вершины уже идут по обходу
+                const auto vertices = s.Vertices();
+                return vertices.empty() ? AxisAligned(s.BoundBox())
+                                        : convex_hull::MinAreaRectangle(vertices).value();
+            } else {
+                return MinAreaBox(s.Points());
+            }
+        },
+        shape);
+}
+
+bool CirclesOverlap(const Circle &lhs, const Circle &rhs) noexcept {
+    const Point2D d = rhs.center_p - lhs.center_p;
+    const double r = lhs.radius + rhs.radius;
+    return d.Dot(d) <= r * r;
+}
+
+BoundingVolumes GetBoundingVolumes(const Shape &shape) {
+    return {GetBoundBox(shape), BoundingCircle(shape), BoundingOrientedBox(shape)};
+}
+
+std::vector<BoundingVolumes> GetBoundingVolumes(std::span<const Shape> shapes) {
+    GEOMETRY_PROFILE_SCOPE("queries::GetBoundingVolumes");
+
+    std::vector<BoundingVolumes> res(shapes.size());
+    parallel::ForEachChunk(
+        shapes.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                res[i] = GetBoundingVolumes(shapes[i]);
+            }
+        },
+        256);
+    return res;
+}
+
+}  // namespace geometry::queries
@@ -0,0 +1,178 @@
+#include "closest_pair.hpp"
+#include "kd_tree.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include "spatial_sort.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+
+namespace geometry::spatial {
+
+namespace {
+
+struct Item {
+    Point2D p;
+    uint32_t index;
+};
+
+// лучшая найденная пара, расстояние в квадрате
+struct Best {
+    double distance = std::numeric_limits<double>::infinity();
+    uint32_t first = 0, second = 0;
+
+    void Update(const Item &a, const Item &b) {
+        const Point2D d = a.p - b.p;
+        if (const double distance2 = d.Dot(d); distance2 < distance) {
+            distance = distance2;
+            first = a.index;
+            second = b.index;
+        }
+    }
+};
+
+// ключ, упорядоченный как double: у отрицательных инвертируются все биты, у остальных выставляется знаковый
+uint64_t OrderedKey(double v) {
+    const auto bits = std::bit_cast<uint64_t>(v);
+    return (bits >> 63) != 0 ? ~bits : bits | (uint64_t{1} << 63);
+}
+
+// точки полосы упорядочены по y: кандидаты -- следующие, пока разность y меньше найденного расстояния
+void ScanStrip(std::span<const Item> strip, Best &best) {
+    for (size_t i = 0; i != strip.size(); ++i) {
+        for (size_t j = i + 1; j != strip.size(); ++j) {
+            const double dy = strip[j].p.y - strip[i].p.y;
+            if (dy * dy >= best.distance) {
+                break;
+            }
+            GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+            best.Update(strip[i], strip[j]);
+        }
+    }
+}
+
+bool ByY(const Item &lhs, const Item &rhs) { return lhs.p.y < rhs.p.y; }
+
+// диапазоны не длиннее решаются перебором
+constexpr size_t kLeafSize = 8;
+
+/*
+ * items упорядочены по x; после вызова -- по y (сортировка слиянием по ходу рекурсии)
+ */
+void Solve(std::span<Item> items, std::span<Item> buffer, Best &best) {
+    if (items.size() <= kLeafSize) {
+        for (size_t i = 0; i != items.size(); ++i) {
+            for (size_t j = i + 1; j != items.size(); ++j) {
+                best.Update(items[i], items[j]);
+            }
+        }
+        std::ranges::sort(items, ByY);
+        return;
+    }
+
+    const size_t middle = items.size() / 2;
+    const double middle_x = items[middle].p.x;
+    Solve(items.first(middle), buffer.first(middle), best);
+    Solve(items.subspan(middle), buffer.subspan(middle), best);
+
+    // слияние в буфер, затем за один проход копирование обратно и сжатие полосы у разделяющей прямой
+    // в начало буфера: запись в буфер не обгоняет чтение
+    std::ranges::merge(items.first(middle), items.subspan(middle), buffer.begin(), ByY);
+    size_t strip = 0;
+    for (size_t i = 0; i != items.size(); ++i) {
+        const Item item = buffer[i];
+        items[i] = item;
+        const double dx = item.p.x - middle_x;
+        if (dx * dx < best.distance) {
+            buffer[strip++] = item;
+        }
+    }
+    ScanStrip(buffer.first(strip), best);
+}
+
+}  // namespace
+
+GeometryResult<std::pair<uint32_t, uint32_t>> ClosestPair(std::span<const Point2D> points) {
+    GEOMETRY_PROFILE_SCOPE("spatial::ClosestPair");
+
+    if (points.size() < 2) {
+        return std::unexpected{GeometryError::InsufficientPoints};
+    }
+
+    std::vector<detail::SortKey> keys(points.size());
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        keys[i] = {OrderedKey(points[i].x), i};
+    }
+    detail::RadixSort(keys);
+    std::vector<Item> items(points.size());
+    for (size_t i = 0; i != keys.size(); ++i) {
+        items[i] = {points[keys[i].second], keys[i].second};
+    }
+    std::vector<Item> buffer(items.size());
+
+    // блоки по x независимы; границы запоминаются для склейки
+    Best best;
+    std::vector<size_t> boundaries;
+    std::mutex mutex;
+    parallel::ForEachChunk(
+        items.size(),
+        [&](size_t begin, size_t end) {
+            // items остаются упорядоченными по x для склейки, блок сортируется по y на копии
+            std::vector<Item> block(items.begin() + begin, items.begin() + end);
+            Best local;
+            Solve(block, std::span{buffer}.subspan(begin, end - begin), local);
+
+            const std::lock_guard lock{mutex};
+            if (local.distance < best.distance) {
+                best = local;
+            }
+            if (begin != 0) {
+                boundaries.push_back(begin);
+            }
+        },
+        1 << 16);
+
+    // пара через границу лежит в полосе шириной найденного расстояния по обе стороны
+    std::vector<Item> strip;
+    for (const size_t boundary : boundaries) {
+        const double x = items[boundary].p.x;
+        strip.clear();
+        for (size_t i = boundary; i != 0; --i) {
+            const double dx = x - items[i - 1].p.x;
+            if (dx * dx >= best.distance) {
+                break;
+            }
+            strip.push_back(items[i - 1]);
+        }
+        for (size_t i = boundary; i != items.size(); ++i) {
+            const double dx = items[i].p.x - x;
+            if (dx * dx >= best.distance) {
+                break;
+            }
+            strip.push_back(items[i]);
+        }
+        std::ranges::sort(strip, ByY);
+        ScanStrip(strip, best);
+    }
+
+    return std::pair{std::min(best.first, best.second), std::max(best.first, best.second)};
+}
+
+std::vector<uint32_t> AllNearestNeighbours(std::span<const Point2D> points) {
+    GEOMETRY_PROFILE_SCOPE("spatial::AllNearestNeighbours");
+
+    const KdTree tree{points};
+    const auto tree_points = tree.Points();
+    const auto indices = tree.Indices();
+
+    std::vector<uint32_t> res(points.size(), kNoNeighbour);
+    parallel::ForEachChunk(points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i != end; ++i) {
+            res[indices[i]] = tree.Nearest(tree_points[i], indices[i]);
+        }
+    });
+    return res;
+}
+
+}  // namespace geometry::spatial
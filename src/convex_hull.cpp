@@ -1,28 +1,41 @@
 #include "convex_hull.hpp"
 #include "geometry.hpp"
+#include "profiling.hpp"
+#include "queries.hpp"
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <limits>
+#include <numbers>
 
 namespace geometry::convex_hull {
 
-double CrossProduct(Point2D p1, Point2D middle, Point2D p2) {
+namespace {
+
+template <Scalar T>
+T CrossProductImpl(BasicPoint2D<T> p1, BasicPoint2D<T> middle, BasicPoint2D<T> p2) {
     auto new_p1 = p1 - middle;
     auto new_p2 = p2 - middle;
     return new_p1.Cross(new_p2);
 }
 
-GeometryResult<std::vector<Point2D>> GrahamScan(std::span<const Point2D> points) {
+template <typename Vector>
+GeometryResult<Vector> GrahamScanImpl(std::span<const typename Vector::value_type> points,
+                                      const typename Vector::allocator_type &alloc) {
+    using Point = typename Vector::value_type;
+
+    GEOMETRY_PROFILE_SCOPE("convex_hull::GrahamScan");
+
     if (points.size() < 3) {
         return std::unexpected{GeometryError::InsufficientPoints};
     }
 
-    std::vector<Point2D> copy_points(points.begin(), points.end());
+    Vector copy_points(points.begin(), points.end(), alloc);
 
     // поиск опорной точки
-    Point2D p0{};
+    Point p0{};
     {
-        auto it = std::ranges::min_element(copy_points, {}, [](const Point2D &p) { return std::tie(p.y, p.x); });
+        auto it = std::ranges::min_element(copy_points, {}, [](const Point &p) { return std::tie(p.y, p.x); });
         assert(it != copy_points.end());
         std::iter_swap(copy_points.begin(), it);
         p0 = copy_points[0];
@@ -31,19 +44,21 @@ GeometryResult<std::vector<Point2D>> GrahamScan(std::span<const Point2D> points)
     // сортировка по полярному углу
     {
         auto range_for_sort = std::ranges::subrange(std::next(copy_points.begin(), 1), std::end(copy_points));
-        std::ranges::sort(range_for_sort, [&p0](const Point2D &lhs, const Point2D &rhs) {
-            auto cross_prod = CrossProduct(lhs, p0, rhs);
-            return is_equal_zero(cross_prod) ? (p0.DistanceTo(lhs) < p0.DistanceTo(rhs)) : (cross_prod > 0.);
+        std::ranges::sort(range_for_sort, [&p0](const Point &lhs, const Point &rhs) {
+            GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+            auto cross_prod = CrossProductImpl(lhs, p0, rhs);
+            return is_equal_zero(cross_prod) ? (p0.DistanceTo(lhs) < p0.DistanceTo(rhs)) : (cross_prod > 0);
         });
     }
 
-    StackForGrahamScan hull{copy_points.size()};
+    BasicStackForGrahamScan<Vector> hull{copy_points.size(), alloc};
 
     for (auto p : copy_points) {
         // удаляется последняя точка со стека, пока она образует невыпуклость
         while (hull.Size() >= 2) {
-            auto cross_prod = CrossProduct(p, hull.Top(), hull.NextToTop());
-            if (cross_prod <= 0.) {
+            GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+            auto cross_prod = CrossProductImpl(p, hull.Top(), hull.NextToTop());
+            if (cross_prod <= 0) {
                 hull.Pop();
             } else {
                 break;
@@ -56,4 +71,238 @@ GeometryResult<std::vector<Point2D>> GrahamScan(std::span<const Point2D> points)
     return std::move(hull).Extract();
 }
 
+// выходной итератор, передающий каждую точку в f
+template <typename F>
+class PointSink {
+public:
+    using difference_type = std::ptrdiff_t;
+
+    explicit PointSink(F &f) : f_{&f} {}
+
+    PointSink &operator=(const Point2D &p) {
+        (*f_)(p);
+        return *this;
+    }
+    PointSink &operator*() { return *this; }
+    PointSink &operator++() { return *this; }
+    PointSink &operator++(int) { return *this; }
+
+private:
+    F *f_;
+};
+
+/*
+ * Вершины многоугольных фигур; окружность разбивается с точностью tolerance
+ */
+template <typename F>
+void ForEachOutlinePoint(const Shape &shape, ChordTolerance tolerance, F &&f) {
+    std::visit(
+        [&]<typename T>(const T &s) {
+            if constexpr (std::is_same_v<T, Circle>) {
+                GenerateCirclePoints(s.center_p, std::abs(s.radius), 0.0, s.Segments(tolerance), PointSink{f});
+            } else if constexpr (std::is_same_v<T, RegularPolygon>) {
+                GenerateCirclePoints(s.center_p, s.radius, 0.0, static_cast<size_t>(s.sides), PointSink{f});
+            } else if constexpr (std::is_same_v<T, Rectangle>) {
+                // прямоугольник выровнен по осям: углы берутся из BoundBox без сортировки вершин
+                const auto bb = s.BoundBox();
+                f(Point2D{bb.min_x, bb.min_y});
+                f(Point2D{bb.max_x, bb.min_y});
+                f(Point2D{bb.max_x, bb.max_y});
+                f(Point2D{bb.min_x, bb.max_y});
+            } else if constexpr (std::is_same_v<T, Polygon>) {
+                std::ranges::for_each(s.Points(), f);
+            } else {
+                std::ranges::for_each(s.Vertices(), f);
+            }
+        },
+        shape);
+}
+
+// охватывающий прямоугольник без перебора вершин: для окружности и правильного многоугольника -- по радиусу
+BoundingBox FastBoundBox(const Shape &shape) {
+    return std::visit(
+        []<typename T>(const T &s) -> BoundingBox {
+            if constexpr (std::is_same_v<T, Circle> || std::is_same_v<T, RegularPolygon>) {
+                const double r = std::abs(s.radius);
+                return {s.center_p.x - r, s.center_p.y - r, s.center_p.x + r, s.center_p.y + r};
+            } else {
+                return s.BoundBox();
+            }
+        },
+        shape);
+}
+
+/*
+ * Выпуклый многоугольник для отсечения: восьмиугольник крайних точек сцены, обход против часовой стрелки
+ */
+class CullingPolygon {
+public:
+    explicit CullingPolygon(std::span<const Shape> shapes) {
+        // направления по возрастанию угла, поэтому крайние точки сразу идут по обходу
+        constexpr double kDiagonal = std::numbers::sqrt2 / 2;
+        constexpr std::array<Point2D, 8> kDirections = {
+            Point2D{1., 0.},  Point2D{kDiagonal, kDiagonal},   Point2D{0., 1.},  Point2D{-kDiagonal, kDiagonal},
+            Point2D{-1., 0.}, Point2D{-kDiagonal, -kDiagonal}, Point2D{0., -1.}, Point2D{kDiagonal, -kDiagonal},
+        };
+
+        std::array<Point2D, 8> extremes{};
+        std::array<double, 8> best{};
+        best.fill(-std::numeric_limits<double>::infinity());
+        auto update = [&](size_t i, const Point2D &p) {
+            if (const double d = p.Dot(kDirections[i]); d > best[i]) {
+                best[i] = d;
+                extremes[i] = p;
+            }
+        };
+
+        // один проход по вершинам фигуры на все 8 направлений; окружность -- точно по опорной функции
+        for (const auto &shape : shapes) {
+            if (const auto *circle = std::get_if<Circle>(&shape)) {
+                for (size_t i = 0; i != kDirections.size(); ++i) {
+                    update(i, circle->center_p + kDirections[i] * std::abs(circle->radius));
+                }
+                continue;
+            }
+
+            ForEachOutlinePoint(shape, {}, [&](const Point2D &p) {
+                for (size_t i = 0; i != kDirections.size(); ++i) {
+                    update(i, p);
+                }
+            });
+        }
+
+        for (size_t i = 0; i != extremes.size(); ++i) {
+            if (best[i] == -std::numeric_limits<double>::infinity()) {
+                continue;
+            }
+            if (size_ == 0 || !(vertices_[size_ - 1] == extremes[i])) {
+                vertices_[size_++] = extremes[i];
+            }
+        }
+        while (size_ > 1 && vertices_[size_ - 1] == vertices_[0]) {
+            --size_;
+        }
+    }
+
+    std::span<const Point2D> Vertices() const noexcept { return {vertices_.data(), size_}; }
+
+    // строго внутри; для вырожденного многоугольника ничего не отсекается
+    bool StrictlyContains(const Point2D &p) const noexcept {
+        if (size_ < 3) {
+            return false;
+        }
+        for (size_t i = 0; i != size_; ++i) {
+            const auto &a = vertices_[i];
+            const auto &b = vertices_[(i + 1) % size_];
+            if (CrossProductImpl(p, a, b) >= -ScalarTraits<double>::kEpsilon) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool StrictlyContains(const BoundingBox &bb) const noexcept {
+        return StrictlyContains(Point2D{bb.min_x, bb.min_y}) && StrictlyContains(Point2D{bb.max_x, bb.min_y}) &&
+               StrictlyContains(Point2D{bb.max_x, bb.max_y}) && StrictlyContains(Point2D{bb.min_x, bb.max_y});
+    }
+
+private:
+    std::array<Point2D, 8> vertices_{};
+    size_t size_ = 0;
+};
+
+template <typename Points>
+Point2D MaxDot(const Points &points, Point2D direction) {
+    return *std::ranges::max_element(points, {}, [&direction](const Point2D &p) { return p.Dot(direction); });
+}
+
+}  // namespace
+
+Point2D SupportPoint(const Shape &shape, Point2D direction) {
+    return std::visit(
+        [&direction]<typename T>(const T &s) -> Point2D {
+            if constexpr (std::is_same_v<T, Circle>) {
+                const double len = direction.Length();
+                if (is_equal_zero(len)) {
+                    return s.center_p;
+                }
+                return s.center_p + direction * (std::abs(s.radius) / len);
+            } else if constexpr (std::is_same_v<T, RegularPolygon>) {
+                if (s.sides == 0) {
+                    return s.center_p;
+                }
+                // вершина, ближайшая по углу к направлению, и её соседи
+                const double step = 2.0 * std::numbers::pi / s.sides;
+                const double angle = std::atan2(direction.y, direction.x) + (s.radius < 0 ? std::numbers::pi : 0.0);
+                const int nearest = static_cast<int>(std::lround(angle / step));
+                const std::array<Point2D, 3> pts = {s.Vertex(nearest - 1), s.Vertex(nearest), s.Vertex(nearest + 1)};
+                return MaxDot(pts, direction);
+            } else if constexpr (std::is_same_v<T, Rectangle>) {
+                // прямоугольник выровнен по осям: угол выбирается по знакам направления
+                const auto bb = s.BoundBox();
+                return {direction.x >= 0 ? bb.max_x : bb.min_x, direction.y >= 0 ? bb.max_y : bb.min_y};
+            } else if constexpr (std::is_same_v<T, Polygon>) {
+                if (s.Points().empty()) {
+                    return s.Center();
+                }
+                return MaxDot(s.Points(), direction);
+            } else {
+                return MaxDot(s.Vertices(), direction);
+            }
+        },
+        shape);
+}
+
+GeometryResult<std::vector<Point2D>> ConvexHullOfShapes(std::span<const Shape> shapes, ChordTolerance tolerance) {
+    GEOMETRY_PROFILE_SCOPE("convex_hull::ConvexHullOfShapes");
+
+    const CullingPolygon culling{shapes};
+
+    // вершины восьмиугольника принадлежат фигурам и всегда остаются кандидатами
+    std::vector<Point2D> candidates(culling.Vertices().begin(), culling.Vertices().end());
+
+    for (const auto &shape : shapes) {
+        if (culling.StrictlyContains(FastBoundBox(shape))) {
+            continue;
+        }
+
+        ForEachOutlinePoint(shape, tolerance, [&](const Point2D &p) {
+            if (!culling.StrictlyContains(p)) {
+                candidates.push_back(p);
+            }
+        });
+    }
+
+    // вершины восьмиугольника совпадают с вершинами фигур; сравнение точное, как у сортировки, -- близкие
+    // точки оставляет GrahamScan
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                                 [](const Point2D &a, const Point2D &b) { return a.x == b.x && a.y == b.y; }),
+                     candidates.end());
+
+    return GrahamScan(candidates);
+}
+
+double CrossProduct(Point2D p1, Point2D middle, Point2D p2) { return CrossProductImpl(p1, middle, p2); }
+
+float CrossProduct(Point2Df p1, Point2Df middle, Point2Df p2) { return CrossProductImpl(p1, middle, p2); }
+
+GeometryResult<std::vector<Point2D>> GrahamScan(std::span<const Point2D> points) {
+    return GrahamScanImpl<std::vector<Point2D>>(points, {});
+}
+
+GeometryResult<std::vector<Point2Df>> GrahamScan(std::span<const Point2Df> points) {
+    return GrahamScanImpl<std::vector<Point2Df>>(points, {});
+}
+
+GeometryResult<std::pmr::vector<Point2D>> GrahamScan(std::span<const Point2D> points,
+                                                     std::pmr::memory_resource *resource) {
+    return GrahamScanImpl<std::pmr::vector<Point2D>>(points, resource);
+}
+
+GeometryResult<std::pmr::vector<Point2Df>> GrahamScan(std::span<const Point2Df> points,
+                                                      std::pmr::memory_resource *resource) {
+    return GrahamScanImpl<std::pmr::vector<Point2Df>>(points, resource);
+}
+
 }  // namespace geometry::convex_hull
\ No newline at end of file
@@ -0,0 +1,484 @@
+#include "headless_export.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace geometry::visualization {
+
+namespace {
+
+static_assert(sizeof(Rgb) == 3, "RasterImage пишет пиксели в файл как есть");
+
+struct Color {
+    std::string_view name;
+    Rgb rgb;
+};
+
+// цвета по номеру альтернативы Shape, как у Draw
+using Palette = std::array<Color, kShapeKinds>;
+
+constexpr Palette kShapePalette = {{
+    {"yellow", {255, 255, 0}},
+    {"blue", {0, 0, 255}},
+    {"green", {0, 128, 0}},
+    {"magenta", {255, 0, 255}},
+    {"red", {255, 0, 0}},
+    {"cyan", {0, 255, 255}},
+}};
+
+constexpr Palette kTrianglePalette = [] {
+    Palette res{};
+    res.fill({"cyan", {0, 255, 255}});
+    return res;
+}();
+
+constexpr double kFillAlpha = 0.5;
+
+/*
+ * Переход из мировых координат в пиксели: сцена вписывается в окно с сохранением пропорций, ось y вниз
+ */
+class Viewport {
+public:
+    Viewport(const BoundingBox &scene, const ExportOptions &options) : scene_{scene}, options_{options} {
+        const double available_w = std::max(static_cast<double>(options.width) - 2 * options.margin, 1.0);
+        const double available_h = std::max(static_cast<double>(options.height) - 2 * options.margin, 1.0);
+
+        const double scale_x = scene.Width() > 0.0 ? available_w / scene.Width() : 1.0;
+        const double scale_y = scene.Height() > 0.0 ? available_h / scene.Height() : 1.0;
+        scale_ = std::min(scale_x, scale_y);
+    }
+
+    Point2D ToPixels(const Point2D &p) const noexcept {
+        return {options_.margin + (p.x - scene_.min_x) * scale_,
+                static_cast<double>(options_.height) - options_.margin - (p.y - scene_.min_y) * scale_};
+    }
+
+    BatchOptions MakeBatchOptions() const {
+        BatchOptions res;
+        res.max_labels = options_.max_labels;
+        if (options_.level_of_detail) {
+            res.pixel_size = 1.0 / scale_;
+        }
+        return res;
+    }
+
+private:
+    BoundingBox scene_;
+    const ExportOptions &options_;
+    double scale_;
+};
+
+BoundingBox TrianglesBoundBox(std::span<const triangulation::DelaunayTriangle> triangles) {
+    if (triangles.empty()) {
+        return {0.0, 0.0, 0.0, 0.0};
+    }
+
+    BoundingBox res{triangles[0].a.x, triangles[0].a.y, triangles[0].a.x, triangles[0].a.y};
+    for (const auto &t : triangles) {
+        for (const auto &p : {t.a, t.b, t.c}) {
+            res.min_x = std::min(res.min_x, p.x);
+            res.min_y = std::min(res.min_y, p.y);
+            res.max_x = std::max(res.max_x, p.x);
+            res.max_y = std::max(res.max_y, p.y);
+        }
+    }
+    return res;
+}
+
+// f(begin, end) для каждой ломаной между разрывами NaN
+template <typename F>
+void ForEachPolyline(const Lines2DDyn &lines, F &&f) {
+    size_t begin = 0;
+    for (size_t i = 0; i != lines.x.size(); ++i) {
+        if (std::isnan(lines.x[i])) {
+            if (i > begin) {
+                f(begin, i);
+            }
+            begin = i + 1;
+        }
+    }
+    if (begin < lines.x.size()) {
+        f(begin, lines.x.size());
+    }
+}
+
+void WriteSvgPoint(BufferedWriter &writer, const Point2D &p) {
+    writer.Write(p.x);
+    writer.Write(' ');
+    writer.Write(p.y);
+}
+
+void WriteSvgBatches(std::ostream &out, const ShapeBatches &batches, const Viewport &viewport,
+                     const ExportOptions &options, const Palette &palette) {
+    BufferedWriter writer{out};
+
+    writer.Write(R"(<svg xmlns="http://www.w3.org/2000/svg" width=")");
+    writer.Write(options.width);
+    writer.Write(R"(" height=")");
+    writer.Write(options.height);
+    writer.Write("\">\n<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n");
+
+    for (size_t kind = 0; kind != kShapeKinds; ++kind) {
+        const auto &outline = batches.outlines[kind];
+        if (!outline.x.empty()) {
+            writer.Write("<path fill=\"");
+            writer.Write(options.fill ? palette[kind].name : "none");
+            writer.Write("\" fill-opacity=\"0.5\" fill-rule=\"evenodd\" stroke=\"");
+            writer.Write(palette[kind].name);
+            writer.Write("\" stroke-width=\"1\" d=\"");
+            ForEachPolyline(outline, [&](size_t begin, size_t end) {
+                writer.Write('M');
+                for (size_t i = begin; i != end; ++i) {
+                    WriteSvgPoint(writer, viewport.ToPixels({outline.x[i], outline.y[i]}));
+                    writer.Write(' ');
+                }
+            });
+            writer.Write("\"/>\n");
+        }
+
+        // мелкие фигуры -- отрезки нулевой длины с квадратным концом, то есть точки в один пиксель
+        const auto &points = batches.points[kind];
+        if (!points.x.empty()) {
+            writer.Write("<path stroke=\"");
+            writer.Write(palette[kind].name);
+            writer.Write("\" stroke-width=\"1\" stroke-linecap=\"square\" d=\"");
+            for (size_t i = 0; i != points.x.size(); ++i) {
+                writer.Write('M');
+                WriteSvgPoint(writer, viewport.ToPixels({points.x[i], points.y[i]}));
+                writer.Write("h0");
+            }
+            writer.Write("\"/>\n");
+        }
+    }
+
+    for (const auto &label : batches.labels) {
+        const auto p = viewport.ToPixels(label.position);
+        writer.Write("<text x=\"");
+        writer.Write(p.x);
+        writer.Write("\" y=\"");
+        writer.Write(p.y);
+        writer.Write("\" font-size=\"14\">");
+        writer.Write(label.index);
+        writer.Write("</text>\n");
+    }
+
+    writer.Write("</svg>\n");
+}
+
+RasterImage RasterizeBatches(const ShapeBatches &batches, const Viewport &viewport, const ExportOptions &options,
+                             const Palette &palette) {
+    RasterImage image{options.width, options.height};
+    std::vector<Point2D> ring;
+
+    auto to_pixels = [&viewport](const Lines2DDyn &lines, size_t i) {
+        return viewport.ToPixels({lines.x[i], lines.y[i]});
+    };
+
+    if (options.fill) {
+        for (size_t kind = 0; kind != kShapeKinds; ++kind) {
+            const auto &outline = batches.outlines[kind];
+            ForEachPolyline(outline, [&](size_t begin, size_t end) {
+                ring.clear();
+                for (size_t i = begin; i != end; ++i) {
+                    ring.push_back(to_pixels(outline, i));
+                }
+                image.FillPolygon(ring, palette[kind].rgb, kFillAlpha);
+            });
+        }
+    }
+
+    for (size_t kind = 0; kind != kShapeKinds; ++kind) {
+        const auto &outline = batches.outlines[kind];
+        ForEachPolyline(outline, [&](size_t begin, size_t end) {
+            auto prev = to_pixels(outline, begin);
+            for (size_t i = begin + 1; i < end; ++i) {
+                const auto cur = to_pixels(outline, i);
+                image.DrawLine(prev, cur, palette[kind].rgb);
+                prev = cur;
+            }
+        });
+
+        const auto &points = batches.points[kind];
+        for (size_t i = 0; i != points.x.size(); ++i) {
+            const auto p = to_pixels(points, i);
+            image.SetPixel(std::llround(p.x), std::llround(p.y), palette[kind].rgb);
+        }
+    }
+
+    return image;
+}
+
+/*
+ * Контрольные суммы PNG и zlib
+ */
+constexpr std::array<uint32_t, 256> kCrcTable = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t n = 0; n != 256; ++n) {
+        uint32_t c = n;
+        for (int k = 0; k != 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[n] = c;
+    }
+    return table;
+}();
+
+class PngChunk {
+public:
+    PngChunk(BufferedWriter &writer, std::string_view type, uint32_t length) : writer_{writer} {
+        WriteU32(writer_, length);
+        Write(type.data(), type.size());
+    }
+
+    ~PngChunk() { WriteU32(writer_, crc_ ^ 0xFFFFFFFFu); }
+
+    void Write(const void *data, size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i != size; ++i) {
+            crc_ = kCrcTable[(crc_ ^ bytes[i]) & 0xFF] ^ (crc_ >> 8);
+        }
+        writer_.WriteBytes(data, size);
+    }
+
+    void WriteU32(uint32_t value) {
+        const auto bytes = BigEndian(value);
+        Write(bytes.data(), bytes.size());
+    }
+
+    static void WriteU32(BufferedWriter &writer, uint32_t value) {
+        const auto bytes = BigEndian(value);
+        writer.WriteBytes(bytes.data(), bytes.size());
+    }
+
+private:
+    static std::array<uint8_t, 4> BigEndian(uint32_t value) {
+        return {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8),
+                static_cast<uint8_t>(value)};
+    }
+
+    BufferedWriter &writer_;
+    uint32_t crc_ = 0xFFFFFFFFu;
+};
+
+}  // namespace
+
+BufferedWriter::BufferedWriter(std::ostream &out, size_t capacity)
+    : out_{out}, buffer_(std::max<size_t>(capacity, 64)) {}
+
+BufferedWriter::~BufferedWriter() { Flush(); }
+
+void BufferedWriter::Write(std::string_view text) { WriteBytes(text.data(), text.size()); }
+
+void BufferedWriter::Write(char c) {
+    if (size_ == buffer_.size()) {
+        Flush();
+    }
+    buffer_[size_++] = c;
+}
+
+void BufferedWriter::Write(double value, int precision) {
+    std::array<char, 64> chars;
+    const auto res =
+        std::to_chars(chars.data(), chars.data() + chars.size(), value, std::chars_format::fixed, precision);
+    WriteBytes(chars.data(), static_cast<size_t>(res.ptr - chars.data()));
+}
+
+void BufferedWriter::Write(size_t value) {
+    std::array<char, 24> chars;
+    const auto res = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+    WriteBytes(chars.data(), static_cast<size_t>(res.ptr - chars.data()));
+}
+
+void BufferedWriter::WriteBytes(const void *data, size_t size) {
+    if (size > buffer_.size() - size_) {
+        Flush();
+        if (size >= buffer_.size()) {
+            out_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+            return;
+        }
+    }
+    std::memcpy(buffer_.data() + size_, data, size);
+    size_ += size;
+}
+
+void BufferedWriter::Flush() {
+    if (size_ != 0) {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(size_));
+        size_ = 0;
+    }
+}
+
+RasterImage::RasterImage(size_t width, size_t height, Rgb background)
+    : width_{width}, height_{height}, pixels_(width * height, background) {}
+
+void RasterImage::SetPixel(int64_t x, int64_t y, Rgb color) noexcept {
+    if (x < 0 || y < 0 || static_cast<size_t>(x) >= width_ || static_cast<size_t>(y) >= height_) {
+        return;
+    }
+    pixels_[static_cast<size_t>(y) * width_ + static_cast<size_t>(x)] = color;
+}
+
+void RasterImage::BlendPixel(int64_t x, int64_t y, Rgb color, double alpha) noexcept {
+    if (x < 0 || y < 0 || static_cast<size_t>(x) >= width_ || static_cast<size_t>(y) >= height_) {
+        return;
+    }
+    auto &pixel = pixels_[static_cast<size_t>(y) * width_ + static_cast<size_t>(x)];
+    auto mix = [alpha](uint8_t dst, uint8_t src) {
+        return static_cast<uint8_t>(std::lround(dst + (src - dst) * alpha));
+    };
+    pixel = {mix(pixel.r, color.r), mix(pixel.g, color.g), mix(pixel.b, color.b)};
+}
+
+void RasterImage::DrawLine(Point2D from, Point2D to, Rgb color) noexcept {
+    if (!std::isfinite(from.x) || !std::isfinite(from.y) || !std::isfinite(to.x) || !std::isfinite(to.y)) {
+        return;
+    }
+
+    int64_t x0 = std::llround(from.x), y0 = std::llround(from.y);
+    const int64_t x1 = std::llround(to.x), y1 = std::llround(to.y);
+
+    const int64_t dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    const int64_t dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int64_t err = dx + dy;
+
+    while (true) {
+        SetPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        const int64_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void RasterImage::FillPolygon(std::span<const Point2D> ring, Rgb color, double alpha) {
+    if (ring.size() < 3 || height_ == 0) {
+        return;
+    }
+
+    const auto [min_it, max_it] = std::ranges::minmax_element(ring, {}, &Point2D::y);
+    // центры пикселей строки row лежат на y = row + 0.5
+    const auto first_row = std::max<int64_t>(0, static_cast<int64_t>(std::ceil(min_it->y - 0.5)));
+    const auto last_row =
+        std::min<int64_t>(static_cast<int64_t>(height_) - 1, static_cast<int64_t>(std::floor(max_it->y - 0.5)));
+
+    for (int64_t row = first_row; row <= last_row; ++row) {
+        const double y = static_cast<double>(row) + 0.5;
+
+        crossings_.clear();
+        for (size_t i = 0; i != ring.size(); ++i) {
+            const auto &p = ring[i];
+            const auto &q = ring[(i + 1) % ring.size()];
+            if ((p.y <= y) != (q.y <= y)) {
+                crossings_.push_back(p.x + (y - p.y) * (q.x - p.x) / (q.y - p.y));
+            }
+        }
+        std::ranges::sort(crossings_);
+
+        for (size_t i = 1; i < crossings_.size(); i += 2) {
+            const auto begin = static_cast<int64_t>(std::ceil(crossings_[i - 1] - 0.5));
+            const auto end = static_cast<int64_t>(std::floor(crossings_[i] - 0.5));
+            for (int64_t x = std::max<int64_t>(begin, 0); x <= std::min<int64_t>(end, width_ - 1); ++x) {
+                BlendPixel(x, row, color, alpha);
+            }
+        }
+    }
+}
+
+void RasterImage::WritePpm(std::ostream &out) const {
+    BufferedWriter writer{out};
+    writer.Write("P6\n");
+    writer.Write(width_);
+    writer.Write(' ');
+    writer.Write(height_);
+    writer.Write("\n255\n");
+    writer.WriteBytes(pixels_.data(), pixels_.size() * sizeof(Rgb));
+}
+
+void RasterImage::WritePng(std::ostream &out) const {
+    BufferedWriter writer{out};
+    constexpr std::array<uint8_t, 8> kSignature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    writer.WriteBytes(kSignature.data(), kSignature.size());
+
+    {
+        PngChunk ihdr{writer, "IHDR", 13};
+        ihdr.WriteU32(static_cast<uint32_t>(width_));
+        ihdr.WriteU32(static_cast<uint32_t>(height_));
+        // 8 бит на канал, RGB, deflate, без фильтров, без чересстрочности
+        constexpr std::array<uint8_t, 5> kFormat = {8, 2, 0, 0, 0};
+        ihdr.Write(kFormat.data(), kFormat.size());
+    }
+
+    // строки изображения с байтом фильтра 0 перед каждой
+    const size_t row_size = 1 + width_ * sizeof(Rgb);
+    std::vector<uint8_t> raw(row_size * height_);
+    for (size_t y = 0; y != height_; ++y) {
+        raw[y * row_size] = 0;
+        std::memcpy(raw.data() + y * row_size + 1, pixels_.data() + y * width_, width_ * sizeof(Rgb));
+    }
+
+    // deflate без сжатия: блоки до 65535 байт с 5-байтовым заголовком
+    constexpr size_t kMaxBlock = 65535;
+    const size_t blocks = std::max<size_t>(1, (raw.size() + kMaxBlock - 1) / kMaxBlock);
+    {
+        PngChunk idat{writer, "IDAT", static_cast<uint32_t>(2 + raw.size() + 5 * blocks + 4)};
+        constexpr std::array<uint8_t, 2> kZlibHeader = {0x78, 0x01};
+        idat.Write(kZlibHeader.data(), kZlibHeader.size());
+
+        uint32_t adler_a = 1, adler_b = 0;
+        for (size_t block = 0; block != blocks; ++block) {
+            const size_t begin = block * kMaxBlock;
+            const size_t size = std::min(kMaxBlock, raw.size() - begin);
+            const auto len = static_cast<uint16_t>(size);
+            const auto nlen = static_cast<uint16_t>(~len);
+            const std::array<uint8_t, 5> header = {static_cast<uint8_t>(block + 1 == blocks ? 1 : 0),
+                                                   static_cast<uint8_t>(len), static_cast<uint8_t>(len >> 8),
+                                                   static_cast<uint8_t>(nlen), static_cast<uint8_t>(nlen >> 8)};
+            idat.Write(header.data(), header.size());
+            idat.Write(raw.data() + begin, size);
+
+            for (size_t i = begin; i != begin + size; ++i) {
+                adler_a = (adler_a + raw[i]) % 65521;
+                adler_b = (adler_b + adler_a) % 65521;
+            }
+        }
+        idat.WriteU32((adler_b << 16) | adler_a);
+    }
+
+    { PngChunk iend{writer, "IEND", 0}; }
+}
+
+void WriteSvg(std::ostream &out, std::span<const Shape> shapes, const ExportOptions &options) {
+    const Viewport viewport{SceneBoundBox(shapes), options};
+    WriteSvgBatches(out, BuildShapeBatches(shapes, viewport.MakeBatchOptions()), viewport, options, kShapePalette);
+}
+
+void WriteSvg(std::ostream &out, std::span<const triangulation::DelaunayTriangle> triangles,
+              const ExportOptions &options) {
+    const Viewport viewport{TrianglesBoundBox(triangles), options};
+    WriteSvgBatches(out, BuildTriangleBatches(triangles, viewport.MakeBatchOptions()), viewport, options,
+                    kTrianglePalette);
+}
+
+RasterImage Rasterize(std::span<const Shape> shapes, const ExportOptions &options) {
+    const Viewport viewport{SceneBoundBox(shapes), options};
+    return RasterizeBatches(BuildShapeBatches(shapes, viewport.MakeBatchOptions()), viewport, options, kShapePalette);
+}
+
+RasterImage Rasterize(std::span<const triangulation::DelaunayTriangle> triangles, const ExportOptions &options) {
+    const Viewport viewport{TrianglesBoundBox(triangles), options};
+    return RasterizeBatches(BuildTriangleBatches(triangles, viewport.MakeBatchOptions()), viewport, options,
+                            kTrianglePalette);
+}
+
+}  // namespace geometry::visualization
@@ -0,0 +1,87 @@
+#include "memory_tracking.hpp"
+#include <cstdlib>
+#include <new>
+
+/*
+ * Подмена глобальных operator new/delete для подсчёта аллокаций
+ *
+ * Линкуется только в unit_tests и geometry_bench, библиотека остаётся без подмен
+ */
+
+namespace {
+
+const bool hooks_installed = [] {
+    geometry::memory::detail::global_hooks_installed.store(true, std::memory_order_relaxed);
+    return true;
+}();
+
+void *Allocate(std::size_t size) noexcept {
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p != nullptr) {
+        geometry::memory::RecordAllocation(size);
+    }
+    return p;
+}
+
+void *AllocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc требует размер, кратный выравниванию
+    const std::size_t rounded = (size + align - 1) / align * align;
+    void *p = std::aligned_alloc(align, rounded == 0 ? align : rounded);
+    if (p != nullptr) {
+        geometry::memory::RecordAllocation(size);
+    }
+    return p;
+}
+
+void Deallocate(void *p) noexcept {
+    if (p != nullptr) {
+        geometry::memory::RecordDeallocation();
+        std::free(p);
+    }
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+    if (void *p = Allocate(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return Allocate(size); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return Allocate(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    if (void *p = AllocateAligned(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void *p) noexcept { Deallocate(p); }
+void operator delete[](void *p) noexcept { Deallocate(p); }
+void operator delete(void *p, std::size_t) noexcept { Deallocate(p); }
+void operator delete[](void *p, std::size_t) noexcept { Deallocate(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { Deallocate(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { Deallocate(p); }
+void operator delete(void *p, std::align_val_t) noexcept { Deallocate(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { Deallocate(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { Deallocate(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { Deallocate(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { Deallocate(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { Deallocate(p); }
@@ -0,0 +1,512 @@
+#include "incremental_delaunay.hpp"
+#include "profiling.hpp"
+#include "spatial_sort.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace geometry::triangulation {
+
+namespace {
+
+double Orient(Point2D a, Point2D b, Point2D c) { return (b - a).Cross(c - a); }
+
+// > 0, если p внутри окружности, описанной около abc (abc против часовой стрелки)
+double InCircle(Point2D a, Point2D b, Point2D c, Point2D p) {
+    const Point2D da = a - p;
+    const Point2D db = b - p;
+    const Point2D dc = c - p;
+    return da.Dot(da) * db.Cross(dc) + db.Dot(db) * dc.Cross(da) + dc.Dot(dc) * da.Cross(db);
+}
+
+// p на прямой ab строго между a и b
+bool StrictlyBetween(Point2D a, Point2D b, Point2D p) { return (p - a).Dot(b - a) > 0 && (p - b).Dot(a - b) > 0; }
+
+}  // namespace
+
+IncrementalDelaunay::IncrementalDelaunay(std::span<const Point2D> points) {
+    // порядок BRIO: случайные раунды сохраняют ожидаемую сложность, кривая Гильберта укорачивает поиск
+    for (const uint32_t i : spatial::BrioOrder(points)) {
+        Insert(points[i]);
+    }
+}
+
+IncrementalDelaunay::VertexId IncrementalDelaunay::Insert(Point2D p) {
+    if (!initialized_) {
+        const auto it = std::ranges::find_if(pending_, [&](VertexId id) { return points_[id] == p; });
+        if (it != pending_.end()) {
+            return *it;
+        }
+        const VertexId id = NewVertex(p);
+        pending_.push_back(id);
+        TryInitialize();
+        return id;
+    }
+
+    const VertexId id = NewVertex(p);
+    const VertexId existing = InsertIntoTriangulation(id);
+    if (existing != id) {
+        ReleaseVertex(id);
+    }
+    return existing;
+}
+
+bool IncrementalDelaunay::Remove(VertexId id) {
+    if (id == kInfinite || !Contains(id)) {
+        return false;
+    }
+
+    if (!initialized_) {
+        std::erase(pending_, id);
+        ReleaseVertex(id);
+        return true;
+    }
+
+    // если после удаления не останется треугольников, точки снова ждут тройку не на одной прямой
+    const bool removed = alive_.size() > 3 && RemoveFromTriangulation(id);
+    ReleaseVertex(id);
+    if (!removed) {
+        Rebuild();
+    } else if (4 * alive_.size() < grid_built_for_) {
+        RebuildGrid();
+    }
+    return true;
+}
+
+GeometryResult<std::vector<DelaunayTriangle>> IncrementalDelaunay::Triangles() const {
+    if (finite_count_ == 0) {
+        return std::unexpected(GeometryError::InsufficientPoints);
+    }
+
+    std::vector<DelaunayTriangle> res;
+    res.reserve(finite_count_);
+    for (const auto &face : faces_) {
+        if (face.v[0] != kNoVertex && !IsGhost(face.v)) {
+            res.emplace_back(points_[face.v[0]], points_[face.v[1]], points_[face.v[2]]);
+        }
+    }
+    return res;
+}
+
+bool IncrementalDelaunay::Conflicts(const std::array<VertexId, 3> &v, Point2D p) const noexcept {
+    // фиктивный треугольник (x, y, inf) конфликтует с точками слева от x -> y, то есть снаружи ребра оболочки
+    for (size_t i = 0; i != 3; ++i) {
+        if (v[i] == kInfinite) {
+            const Point2D x = points_[v[(i + 1) % 3]];
+            const Point2D y = points_[v[(i + 2) % 3]];
+            const double orientation = Orient(x, y, p);
+            return orientation > 0 || (orientation == 0 && StrictlyBetween(x, y, p));
+        }
+    }
+    return InCircle(points_[v[0]], points_[v[1]], points_[v[2]], p) > 0;
+}
+
+IncrementalDelaunay::VertexId IncrementalDelaunay::NewVertex(Point2D p) {
+    VertexId id;
+    if (!free_vertices_.empty()) {
+        id = free_vertices_.back();
+        free_vertices_.pop_back();
+        points_[id] = p;
+    } else {
+        id = static_cast<VertexId>(points_.size());
+        points_.push_back(p);
+        vertex_face_.push_back(kNoFace);
+        alive_index_.push_back(kNoVertex);
+        slot_.push_back(kNoFace);
+    }
+
+    alive_index_[id] = static_cast<VertexId>(alive_.size());
+    alive_.push_back(id);
+    return id;
+}
+
+void IncrementalDelaunay::ReleaseVertex(VertexId id) {
+    const VertexId index = alive_index_[id];
+    alive_[index] = alive_.back();
+    alive_index_[alive_[index]] = index;
+    alive_.pop_back();
+
+    alive_index_[id] = kNoVertex;
+    vertex_face_[id] = kNoFace;
+    free_vertices_.push_back(id);
+}
+
+uint32_t IncrementalDelaunay::NewFace(const std::array<VertexId, 3> &v) {
+    uint32_t face;
+    if (!free_faces_.empty()) {
+        face = free_faces_.back();
+        free_faces_.pop_back();
+    } else {
+        face = static_cast<uint32_t>(faces_.size());
+        faces_.emplace_back();
+        visited_.push_back(0);
+    }
+
+    faces_[face] = {v, {kNoFace, kNoFace, kNoFace}};
+    for (const VertexId x : v) {
+        vertex_face_[x] = face;
+    }
+    if (!IsGhost(v)) {
+        ++finite_count_;
+    }
+    last_face_ = face;
+    return face;
+}
+
+void IncrementalDelaunay::ReleaseFace(uint32_t face) {
+    if (!IsGhost(faces_[face].v)) {
+        --finite_count_;
+    }
+    faces_[face].v[0] = kNoVertex;
+    free_faces_.push_back(face);
+}
+
+void IncrementalDelaunay::Link(uint32_t face, uint32_t i, uint32_t other, uint32_t j) noexcept {
+    faces_[face].n[i] = other;
+    faces_[other].n[j] = face;
+}
+
+uint32_t IncrementalDelaunay::IndexOf(uint32_t face, uint32_t neighbour) const noexcept {
+    const auto &n = faces_[face].n;
+    return n[0] == neighbour ? 0 : n[1] == neighbour ? 1 : 2;
+}
+
+void IncrementalDelaunay::Rebuild() {
+    initialized_ = false;
+    faces_.clear();
+    free_faces_.clear();
+    visited_.clear();
+    finite_count_ = 0;
+    std::ranges::fill(vertex_face_, kNoFace);
+
+    pending_.assign(alive_.begin(), alive_.end());
+    TryInitialize();
+}
+
+void IncrementalDelaunay::TryInitialize() {
+    if (pending_.size() < 3) {
+        return;
+    }
+
+    // повторов среди ожидающих точек нет, поэтому первые две различны
+    VertexId a = pending_[0];
+    VertexId b = pending_[1];
+    const auto it = std::ranges::find_if(pending_, [&](VertexId c) {
+        return Orient(points_[a], points_[b], points_[c]) != 0;
+    });
+    if (it == pending_.end()) {
+        return;
+    }
+    VertexId c = *it;
+    if (Orient(points_[a], points_[b], points_[c]) < 0) {
+        std::swap(b, c);
+    }
+
+    initialized_ = true;
+    const uint32_t abc = NewFace({a, b, c});
+    const uint32_t ghost_ab = NewFace({b, a, kInfinite});
+    const uint32_t ghost_bc = NewFace({c, b, kInfinite});
+    const uint32_t ghost_ca = NewFace({a, c, kInfinite});
+    Link(abc, 0, ghost_bc, 2);
+    Link(abc, 1, ghost_ca, 2);
+    Link(abc, 2, ghost_ab, 2);
+    Link(ghost_ab, 0, ghost_ca, 1);
+    Link(ghost_ab, 1, ghost_bc, 0);
+    Link(ghost_bc, 1, ghost_ca, 0);
+
+    const auto rest = std::exchange(pending_, {});
+    for (const VertexId id : rest) {
+        if (id != a && id != b && id != c) {
+            InsertIntoTriangulation(id);
+        }
+    }
+    RebuildGrid();
+}
+
+size_t IncrementalDelaunay::GridCell(Point2D p) const noexcept {
+    // точки вне сетки прижимаются к крайним клеткам
+    const double x = std::clamp((p.x - grid_box_.min_x) / grid_cell_, 0.0, static_cast<double>(grid_columns_ - 1));
+    const double y = std::clamp((p.y - grid_box_.min_y) / grid_cell_, 0.0, static_cast<double>(grid_rows_ - 1));
+    return static_cast<size_t>(y) * grid_columns_ + static_cast<size_t>(x);
+}
+
+void IncrementalDelaunay::RebuildGrid() {
+    grid_.clear();
+    grid_built_for_ = alive_.size();
+    if (alive_.empty()) {
+        return;
+    }
+
+    grid_box_ = {points_[alive_[0]].x, points_[alive_[0]].y, points_[alive_[0]].x, points_[alive_[0]].y};
+    for (const VertexId id : alive_) {
+        grid_box_.min_x = std::min(grid_box_.min_x, points_[id].x);
+        grid_box_.min_y = std::min(grid_box_.min_y, points_[id].y);
+        grid_box_.max_x = std::max(grid_box_.max_x, points_[id].x);
+        grid_box_.max_y = std::max(grid_box_.max_y, points_[id].y);
+    }
+
+    const double cells = std::max<double>(1, alive_.size() / 2);
+    const double width = grid_box_.Width();
+    const double height = grid_box_.Height();
+    grid_cell_ = std::max({std::sqrt(width * height / cells), std::max(width, height) / cells,
+                           std::numeric_limits<double>::min()});
+    grid_columns_ = static_cast<size_t>(width / grid_cell_) + 1;
+    grid_rows_ = static_cast<size_t>(height / grid_cell_) + 1;
+
+    grid_.assign(grid_columns_ * grid_rows_, kNoVertex);
+    for (const VertexId id : alive_) {
+        grid_[GridCell(points_[id])] = id;
+    }
+}
+
+uint32_t IncrementalDelaunay::Locate(Point2D p) {
+    // прыжок: вершина из клетки p, иначе ближайшая из ~n^(1/3) случайных вершин, уже вошедших в триангуляцию
+    uint32_t face = last_face_;
+    const VertexId hint = grid_.empty() ? kNoVertex : grid_[GridCell(p)];
+    if (hint != kNoVertex && Contains(hint) && vertex_face_[hint] != kNoFace) {
+        face = vertex_face_[hint];
+    } else {
+        const auto samples = static_cast<size_t>(std::cbrt(static_cast<double>(alive_.size()))) + 1;
+        std::uniform_int_distribution<size_t> dist(0, alive_.size() - 1);
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i != samples; ++i) {
+            const VertexId id = alive_[dist(gen_)];
+            const Point2D d = points_[id] - p;
+            if (vertex_face_[id] != kNoFace && d.Dot(d) < best) {
+                best = d.Dot(d);
+                face = vertex_face_[id];
+            }
+        }
+    }
+
+    // из фиктивного треугольника -- в соседний настоящий
+    for (size_t i = 0; i != 3; ++i) {
+        if (faces_[face].v[i] == kInfinite) {
+            face = faces_[face].n[i];
+            break;
+        }
+    }
+
+    // проход по соседям через рёбра, снаружи которых лежит p
+    uint32_t from = kNoFace;
+    for (size_t steps = 0; steps <= faces_.size(); ++steps) {
+        const Face &f = faces_[face];
+        if (IsGhost(f.v)) {
+            return face;
+        }
+
+        uint32_t next = kNoFace;
+        for (size_t i = 0; i != 3; ++i) {
+            if (f.n[i] != from && Orient(points_[f.v[(i + 1) % 3]], points_[f.v[(i + 2) % 3]], p) < 0) {
+                next = f.n[i];
+                break;
+            }
+        }
+        if (next == kNoFace) {
+            return face;
+        }
+        from = face;
+        face = next;
+    }
+    return face;
+}
+
+IncrementalDelaunay::VertexId IncrementalDelaunay::InsertIntoTriangulation(VertexId id) {
+    const Point2D p = points_[id];
+
+    // полость: связная область треугольников, чья описанная окружность содержит p
+    cavity_.clear();
+    boundary_.clear();
+    const uint32_t start = Locate(p);
+    ++epoch_;
+    visited_[start] = epoch_;
+    cavity_.push_back(start);
+    for (size_t k = 0; k != cavity_.size(); ++k) {
+        const Face &face = faces_[cavity_[k]];
+        for (const VertexId x : face.v) {
+            if (x != kInfinite && points_[x] == p) {
+                return x;
+            }
+        }
+
+        for (uint32_t i = 0; i != 3; ++i) {
+            const uint32_t neighbour = face.n[i];
+            if (visited_[neighbour] == epoch_) {
+                continue;
+            }
+            if (Conflicts(faces_[neighbour].v, p)) {
+                visited_[neighbour] = epoch_;
+                cavity_.push_back(neighbour);
+            } else {
+                boundary_.push_back({face.v[(i + 1) % 3], face.v[(i + 2) % 3], neighbour,
+                                     IndexOf(neighbour, cavity_[k])});
+            }
+        }
+    }
+    GEOMETRY_PROFILE_COUNT(TrianglesVisited, cavity_.size());
+
+    for (const uint32_t face : cavity_) {
+        ReleaseFace(face);
+    }
+
+    // веер (a, b, p) по границе полости; соседи внутри веера -- через треугольник, начинающийся в b
+    for (const auto &edge : boundary_) {
+        const uint32_t face = NewFace({edge.a, edge.b, id});
+        Link(face, 2, edge.outer, edge.outer_index);
+        slot_[edge.a] = face;
+    }
+    for (const auto &edge : boundary_) {
+        Link(slot_[edge.a], 0, slot_[edge.b], 1);
+    }
+    for (const auto &edge : boundary_) {
+        slot_[edge.a] = kNoFace;
+    }
+
+    if (alive_.size() > 2 * grid_built_for_ + 16) {
+        RebuildGrid();
+    } else if (!grid_.empty()) {
+        grid_[GridCell(p)] = id;
+    }
+    return id;
+}
+
+bool IncrementalDelaunay::RemoveFromTriangulation(VertexId id) {
+    // звезда вершины против часовой стрелки: link_ -- вершины границы дыры, across_ -- треугольники за её рёбрами
+    link_.clear();
+    across_.clear();
+    cavity_.clear();
+    size_t finite_star = 0;
+
+    const uint32_t start = vertex_face_[id];
+    uint32_t face = start;
+    do {
+        const Face &f = faces_[face];
+        const size_t i = f.v[0] == id ? 0 : f.v[1] == id ? 1 : 2;
+        link_.push_back(f.v[(i + 1) % 3]);
+        across_.push_back({f.n[i], IndexOf(f.n[i], face)});
+        cavity_.push_back(face);
+        finite_star += IsGhost(f.v) ? 0 : 1;
+        face = f.n[(i + 1) % 3];
+    } while (face != start);
+
+    if (finite_star == finite_count_) {
+        return false;
+    }
+
+    // подсказка сетки переходит к соседней вершине
+    if (!grid_.empty()) {
+        VertexId &hint = grid_[GridCell(points_[id])];
+        if (hint == id) {
+            hint = link_[0] != kInfinite ? link_[0] : link_[1];
+        }
+    }
+    GEOMETRY_PROFILE_COUNT(TrianglesVisited, cavity_.size());
+
+    for (const uint32_t f : cavity_) {
+        ReleaseFace(f);
+    }
+
+    // кольцо вершин дыры
+    const size_t k = link_.size();
+    prev_.resize(k);
+    next_.resize(k);
+    for (size_t i = 0; i != k; ++i) {
+        prev_[i] = (i + k - 1) % k;
+        next_[i] = (i + 1) % k;
+    }
+
+    // треугольник (prev, j, next) закрывает часть дыры, j уходит из кольца; возвращает соседа prev
+    size_t remaining = k;
+    auto clip = [&](size_t j) {
+        const size_t a = prev_[j];
+        const size_t c = next_[j];
+        const uint32_t ear = NewFace({link_[a], link_[j], link_[c]});
+        Link(ear, 2, across_[a].face, across_[a].index);
+        Link(ear, 0, across_[j].face, across_[j].index);
+        across_[a] = {ear, 1};
+        next_[a] = c;
+        prev_[c] = a;
+        --remaining;
+        return a;
+    };
+
+    size_t j = 0;
+    if (std::ranges::find(link_, kInfinite) == link_.end()) {
+        /*
+         * Внутренняя вершина: очередь ушей по степени p относительно их описанных окружностей (Devillers).
+         * Ухо допустимо, если оно выпуклое и p остаётся внутри оставшегося кольца; допустимое ухо с наибольшей
+         * степенью -- треугольник Делоне. Ключ зависит только от самого уха, поэтому после отсечения
+         * пересчитываются лишь два соседних уха: O(k log k) на дыру из k вершин
+         */
+        const Point2D p = points_[id];
+        // степень p, то есть |p - o|^2 - r^2; у недопустимого уха -- минус бесконечность
+        auto key = [&](size_t q) {
+            const Point2D a = points_[link_[prev_[q]]];
+            const Point2D b = points_[link_[q]];
+            const Point2D c = points_[link_[next_[q]]];
+            const double orientation = Orient(a, b, c);
+            return orientation > 0 && Orient(a, c, p) >= 0 ? -InCircle(a, b, c, p) / orientation
+                                                            : -std::numeric_limits<double>::infinity();
+        };
+        ear_version_.assign(k, 0);
+        ears_.clear();
+        for (size_t q = 0; q != k; ++q) {
+            ears_.push_back({key(q), static_cast<uint32_t>(q), 0});
+        }
+        std::ranges::make_heap(ears_, {}, &Ear::key);
+
+        while (remaining > 3) {
+            // устаревшие записи пропускаются; невыпуклые уши в конце очереди и берутся, только если
+            // выпуклых не осталось из-за погрешности
+            while (ears_.front().version != ear_version_[ears_.front().vertex]) {
+                std::ranges::pop_heap(ears_, {}, &Ear::key);
+                ears_.pop_back();
+            }
+            j = ears_.front().vertex;
+            ++ear_version_[j];
+            j = clip(j);
+            for (const size_t q : {j, next_[j]}) {
+                ears_.push_back({key(q), static_cast<uint32_t>(q), ++ear_version_[q]});
+                std::ranges::push_heap(ears_, {}, &Ear::key);
+            }
+        }
+    } else {
+        // вершина оболочки: в кольце бесконечная вершина, ухо годится, если оно выпуклое и его окружность
+        // не содержит остальных вершин дыры; дыра у оболочки мала, поэтому кольцо просто обходится по кругу
+        auto is_ear = [this](size_t a, size_t j, size_t c) {
+            const std::array<VertexId, 3> v{link_[a], link_[j], link_[c]};
+            if (!IsGhost(v) && Orient(points_[v[0]], points_[v[1]], points_[v[2]]) <= 0) {
+                return false;
+            }
+            for (size_t q = next_[c]; q != a; q = next_[q]) {
+                if (link_[q] != kInfinite && Conflicts(v, points_[link_[q]])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        size_t misses = 0;
+        while (remaining > 3) {
+            // после полного круга без подходящего уха (погрешность вычислений) берётся текущее
+            if (misses < remaining && !is_ear(prev_[j], j, next_[j])) {
+                j = next_[j];
+                ++misses;
+                continue;
+            }
+            j = clip(j);
+            misses = 0;
+        }
+    }
+
+    const size_t a = prev_[j];
+    const size_t c = next_[j];
+    const uint32_t last = NewFace({link_[a], link_[j], link_[c]});
+    Link(last, 2, across_[a].face, across_[a].index);
+    Link(last, 0, across_[j].face, across_[j].index);
+    Link(last, 1, across_[c].face, across_[c].index);
+    return true;
+}
+
+}  // namespace geometry::triangulation
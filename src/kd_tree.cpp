@@ -0,0 +1,273 @@
+#include "kd_tree.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+
+namespace geometry::spatial {
+
+KdTree::KdTree(std::span<const Point2D> points) : axes_(points.size(), 0) {
+    GEOMETRY_PROFILE_SCOPE("spatial::KdTree");
+
+    std::vector<Item> items(points.size());
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        items[i] = {points[i], i};
+    }
+
+    // верхние уровни дают около четырёх поддеревьев на поток
+    std::vector<std::pair<size_t, size_t>> ranges = {{0, items.size()}};
+    const size_t levels = std::bit_width(4 * parallel::ThreadsCount() - 1);
+    for (size_t level = 0; level != levels; ++level) {
+        std::vector<std::pair<size_t, size_t>> next;
+        for (const auto &[begin, end] : ranges) {
+            if (end - begin <= kLeafSize) {
+                next.emplace_back(begin, end);
+                continue;
+            }
+            Split(items, begin, end);
+            const size_t middle = begin + (end - begin) / 2;
+            next.emplace_back(begin, middle);
+            next.emplace_back(middle + 1, end);
+        }
+        ranges.swap(next);
+    }
+    parallel::ForEachChunk(
+        ranges.size(),
+        [&](size_t first, size_t last) {
+            for (size_t r = first; r != last; ++r) {
+                Build(items, ranges[r].first, ranges[r].second);
+            }
+        },
+        1);
+
+    points_.resize(items.size());
+    indices_.resize(items.size());
+    for (size_t i = 0; i != items.size(); ++i) {
+        points_[i] = items[i].p;
+        indices_[i] = items[i].index;
+    }
+    if (!points_.empty()) {
+        const auto [min_x, max_x] = std::ranges::minmax(points_, {}, &Point2D::x);
+        const auto [min_y, max_y] = std::ranges::minmax(points_, {}, &Point2D::y);
+        box_ = {min_x.x, min_y.y, max_x.x, max_y.y};
+    }
+}
+
+void KdTree::Split(std::span<Item> items, size_t begin, size_t end) {
+    double min_x = items[begin].p.x;
+    double max_x = min_x;
+    double min_y = items[begin].p.y;
+    double max_y = min_y;
+    for (size_t i = begin + 1; i != end; ++i) {
+        min_x = std::min(min_x, items[i].p.x);
+        max_x = std::max(max_x, items[i].p.x);
+        min_y = std::min(min_y, items[i].p.y);
+        max_y = std::max(max_y, items[i].p.y);
+    }
+
+    const size_t middle = begin + (end - begin) / 2;
+    const uint8_t axis = max_y - min_y > max_x - min_x ? 1 : 0;
+    axes_[middle] = axis;
+    // отдельные сравнения для осей: без ветвления внутри nth_element
+    const auto first = items.begin() + begin;
+    const auto nth = items.begin() + middle;
+    const auto last = items.begin() + end;
+    if (axis == 0) {
+        std::nth_element(first, nth, last, [](const Item &lhs, const Item &rhs) { return lhs.p.x < rhs.p.x; });
+    } else {
+        std::nth_element(first, nth, last, [](const Item &lhs, const Item &rhs) { return lhs.p.y < rhs.p.y; });
+    }
+}
+
+void KdTree::Build(std::span<Item> items, size_t begin, size_t end) {
+    while (end - begin > kLeafSize) {
+        Split(items, begin, end);
+        const size_t middle = begin + (end - begin) / 2;
+        Build(items, begin, middle);
+        begin = middle + 1;
+    }
+}
+
+uint32_t KdTree::Nearest(Point2D p, uint32_t skip) const noexcept {
+    uint32_t res = kNoPoint;
+    double best = std::numeric_limits<double>::infinity();
+
+    std::array<Pending, kMaxDepth> stack;
+    size_t top = 0;
+    stack[top++] = {0, points_.size(), 0.0};
+
+    auto visit = [&](size_t i) {
+        const Point2D d = points_[i] - p;
+        if (const double distance = d.Dot(d); distance < best && indices_[i] != skip) {
+            best = distance;
+            res = indices_[i];
+        }
+    };
+
+    while (top != 0) {
+        auto [begin, end, bound] = stack[--top];
+        if (bound >= best) {
+            continue;
+        }
+        // спуск в ближнее поддерево без стека, дальнее откладывается
+        while (end - begin > kLeafSize) {
+            const size_t middle = begin + (end - begin) / 2;
+            visit(middle);
+            const double diff = Coordinate(p, axes_[middle]) - Coordinate(points_[middle], axes_[middle]);
+            const Pending far = diff < 0 ? Pending{middle + 1, end, diff * diff} : Pending{begin, middle, diff * diff};
+            if (diff < 0) {
+                end = middle;
+            } else {
+                begin = middle + 1;
+            }
+            if (far.bound < best) {
+                stack[top++] = far;
+            }
+        }
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, end - begin);
+        for (size_t i = begin; i != end; ++i) {
+            visit(i);
+        }
+    }
+    return res;
+}
+
+size_t KdTree::KNearest(Point2D p, std::span<Neighbour> out) const noexcept {
+    if (out.empty()) {
+        return 0;
+    }
+
+    // пока куча не заполнена, отсечения нет; дальше -- по самому дальнему из найденных
+    auto by_distance = [](const Neighbour &lhs, const Neighbour &rhs) { return lhs.distance2 < rhs.distance2; };
+    size_t found = 0;
+    auto worst = [&] { return found == out.size() ? out.front().distance2 : std::numeric_limits<double>::infinity(); };
+
+    std::array<Pending, kMaxDepth> stack;
+    size_t top = 0;
+    stack[top++] = {0, points_.size(), 0.0};
+
+    auto visit = [&](size_t i) {
+        const Point2D d = points_[i] - p;
+        const double distance2 = d.Dot(d);
+        if (found < out.size()) {
+            out[found++] = {indices_[i], distance2};
+            std::ranges::push_heap(out.first(found), by_distance);
+        } else if (distance2 < out.front().distance2) {
+            std::ranges::pop_heap(out, by_distance);
+            out.back() = {indices_[i], distance2};
+            std::ranges::push_heap(out, by_distance);
+        }
+    };
+
+    while (top != 0) {
+        auto [begin, end, bound] = stack[--top];
+        if (bound >= worst()) {
+            continue;
+        }
+        while (end - begin > kLeafSize) {
+            const size_t middle = begin + (end - begin) / 2;
+            visit(middle);
+            const double diff = Coordinate(p, axes_[middle]) - Coordinate(points_[middle], axes_[middle]);
+            if (diff * diff < worst()) {
+                stack[top++] = diff < 0 ? Pending{middle + 1, end, diff * diff} : Pending{begin, middle, diff * diff};
+            }
+            if (diff < 0) {
+                end = middle;
+            } else {
+                begin = middle + 1;
+            }
+        }
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, end - begin);
+        for (size_t i = begin; i != end; ++i) {
+            visit(i);
+        }
+    }
+
+    std::ranges::sort_heap(out.first(found), by_distance);
+    return found;
+}
+
+size_t KdTree::RangeCount(const BoundingBox &box) const noexcept {
+    // диапазон вместе с областью плоскости, которую покрывает его поддерево
+    struct Region {
+        size_t begin, end;
+        BoundingBox cell;
+    };
+    auto inside = [&box](const BoundingBox &cell) {
+        return box.min_x <= cell.min_x && cell.max_x <= box.max_x && box.min_y <= cell.min_y &&
+               cell.max_y <= box.max_y;
+    };
+    auto contains = [&box](Point2D p) {
+        return box.min_x <= p.x && p.x <= box.max_x && box.min_y <= p.y && p.y <= box.max_y;
+    };
+
+    size_t res = 0;
+    std::array<Region, kMaxDepth + 1> stack;
+    size_t top = 0;
+    stack[top++] = {0, points_.size(), box_};
+
+    while (top != 0) {
+        const auto [begin, end, cell] = stack[--top];
+        if (begin == end || !cell.Overlaps(box)) {
+            continue;
+        }
+        if (inside(cell)) {
+            res += end - begin;
+            continue;
+        }
+        if (end - begin <= kLeafSize) {
+            GEOMETRY_PROFILE_COUNT(PredicateEvaluations, end - begin);
+            for (size_t i = begin; i != end; ++i) {
+                res += contains(points_[i]) ? 1 : 0;
+            }
+            continue;
+        }
+
+        const size_t middle = begin + (end - begin) / 2;
+        res += contains(points_[middle]) ? 1 : 0;
+        BoundingBox left = cell;
+        BoundingBox right = cell;
+        if (axes_[middle] == 0) {
+            left.max_x = right.min_x = points_[middle].x;
+        } else {
+            left.max_y = right.min_y = points_[middle].y;
+        }
+        stack[top++] = {begin, middle, left};
+        stack[top++] = {middle + 1, end, right};
+    }
+    return res;
+}
+
+std::vector<KdTree::Neighbour> KdTree::KNearest(std::span<const Point2D> queries, size_t k) const {
+    GEOMETRY_PROFILE_SCOPE("spatial::KdTree::KNearest");
+
+    std::vector<Neighbour> res(queries.size() * k);
+    parallel::ForEachChunk(
+        queries.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                KNearest(queries[i], std::span{res}.subspan(i * k, k));
+            }
+        },
+        256);
+    return res;
+}
+
+std::vector<size_t> KdTree::RangeCount(std::span<const BoundingBox> boxes) const {
+    GEOMETRY_PROFILE_SCOPE("spatial::KdTree::RangeCount");
+
+    std::vector<size_t> res(boxes.size());
+    parallel::ForEachChunk(
+        boxes.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                res[i] = RangeCount(boxes[i]);
+            }
+        },
+        256);
+    return res;
+}
+
+}  // namespace geometry::spatial
@@ -1,21 +1,27 @@
 #include "convex_hull.hpp"
 #include "geometry.hpp"
+#include "headless_export.hpp"
 #include "intersections.hpp"
+#include "profiling.hpp"
 #include "queries.hpp"
 #include "shape_utils.hpp"
 #include "triangulation.hpp"
 #include "visualization.hpp"
 
 #include <algorithm>
+#include <fstream>
+#include <iostream>
 #include <print>
 #include <ranges>
 
 using namespace geometry;
+using namespace std::string_view_literals;
 
 namespace rng = std::ranges;
 namespace views = std::ranges::views;
 
 void PrintAllIntersections(const Shape &shape, std::span<const Shape> others) {
+    GEOMETRY_PROFILE_SCOPE("main::PrintAllIntersections");
     std::println("\n=== Intersections ===");
 
     rng::for_each(others | views::filter([&shape](const auto &other) { return &other != &shape; }),
@@ -30,6 +36,7 @@ void PrintAllIntersections(const Shape &shape, std::span<const Shape> others) {
 }
 
 void PrintDistancesFromPointToShapes(Point2D p, std::span<const Shape> shapes) {
+    GEOMETRY_PROFILE_SCOPE("main::PrintDistancesFromPointToShapes");
     std::println("\n=== Distance from Point Test ===");
     std::println("  testing point: {} ", p);
 
@@ -39,14 +46,12 @@ void PrintDistancesFromPointToShapes(Point2D p, std::span<const Shape> shapes) {
 }
 
 void PerformShapeAnalysis(std::span<const Shape> shapes) {
+    GEOMETRY_PROFILE_SCOPE("main::PerformShapeAnalysis");
     std::println("\n=== Shape Analysis ===");
 
-    std::println("  bounding box collisions:");
-    auto colliding_pairs = views::cartesian_product(shapes, shapes) | views::filter([](const auto &pair) {
-                               auto &[s1, s2] = pair;
-                               return &s1 < &s2 && queries::BoundingBoxesOverlap(s1, s2);
-                           });
-    rng::for_each(colliding_pairs, [](const auto &pair) {
+    // пересечение прямоугольников -- только кандидат, пара проверяется точно
+    std::println("  collisions:");
+    rng::for_each(utils::FindAllOverlaps(shapes), [](const auto &pair) {
         auto &[s1, s2] = pair;
         std::println("    - {} and {}", s1, s2);
     });
@@ -79,6 +84,7 @@ void PerformShapeAnalysis(std::span<const Shape> shapes) {
 }
 
 void PerformExtraShapeAnalysis(std::span<const Shape> shapes) {
+    GEOMETRY_PROFILE_SCOPE("main::PerformExtraShapeAnalysis");
     std::println("\n=== Shape Extra Analysis ===");
 
     auto high_shapes = shapes |
@@ -98,7 +104,29 @@ void PerformExtraShapeAnalysis(std::span<const Shape> shapes) {
     }
 }
 
-int main() {
+// допустимое отклонение контура окружности от дуги при построении оболочки
+constexpr ChordTolerance kHullTolerance{0.05};
+
+/*
+ * Показывает график в окне gnuplot, а с --headless сохраняет его в <name>.svg и <name>.png
+ */
+template <typename T>
+void Show(std::span<const T> items, std::string_view name, bool headless) {
+    if (!headless) {
+        geometry::visualization::Draw(items);
+        return;
+    }
+
+    std::ofstream svg{std::format("{}.svg", name)};
+    geometry::visualization::WriteSvg(svg, items, {.max_labels = 200});
+    std::ofstream png{std::format("{}.png", name), std::ios::binary};
+    geometry::visualization::Rasterize(items).WritePng(png);
+    std::println("\nSaved {0}.svg and {0}.png", name);
+}
+
+int main(int argc, char *argv[]) {
+    const bool headless = rng::contains(std::span(argv, argc) | views::drop(1), "--headless"sv);
+
     utils::ShapeGenerator generator(-50.0, 50.0, 5.0, 25.0);
     std::vector<Shape> shapes = generator.GenerateShapes(15);
 
@@ -127,37 +155,21 @@ int main() {
     //
     // Важно: после изучения графика - нажмите Enter чтобы продолжить выполнение и построить 2ой график
     //
-    geometry::visualization::Draw(shapes);
-
-    //
-    // Формируем список из вершин всех фигур
-    //
-
-    std::vector<Point2D> points;
-    {
-
-        auto all_vertices_view = shapes | views::transform([](const Shape &shape) {
-                                     return std::visit(
-                                         [](const auto &shape) {
-                                             const auto vts = shape.Vertices();
-                                             std::vector<Point2D> pts(std::begin(vts), std::end(vts));
-                                             return pts;
-                                         },
-                                         shape);
-                                 }) |
-                                 views::join;
-        rng::copy(all_vertices_view, std::back_inserter(points));
-    }
+    Show<Shape>(shapes, "shapes", headless);
 
     //
-    // Находим список точек, для построения выпуклой оболочки - convex hull - алгоритмом Грэхема
-    // Создаём из них объект класса `Polygon` и добавляем его в список shapes
+    // Находим выпуклую оболочку всех фигур по их крайним точкам - без общего списка вершин
+    // Создаём из неё объект класса `Polygon` и добавляем его в список shapes
     // Рисуем все фигуры
     //
 
-    if (auto hull_result = geometry::convex_hull::GrahamScan(points)) {
+    auto hull_result = [&shapes] {
+        GEOMETRY_PROFILE_SCOPE("main::ConvexHull");
+        return geometry::convex_hull::ConvexHullOfShapes(shapes, kHullTolerance);
+    }();
+    if (hull_result) {
         shapes.push_back(geometry::Polygon(*hull_result));
-        geometry::visualization::Draw(shapes);
+        Show<Shape>(shapes, "convex_hull", headless);
     } else {
         std::println("Error {}", static_cast<int>(hull_result.error()));
     }
@@ -169,12 +181,27 @@ int main() {
     {
         std::vector<Point2D> points = {{0, 0}, {10, 0}, {5, 8}, {15, 5}, {2, 12}};
 
-        if (auto triangulation_result = geometry::triangulation::DelaunayTriangulation(points)) {
-            geometry::visualization::Draw(triangulation_result.value());
+        // замер без ожидания окна Show
+        auto triangulation_result = [&points] {
+            GEOMETRY_PROFILE_SCOPE("main::Triangulation");
+            return geometry::triangulation::DelaunayTriangulation(points);
+        }();
+        if (triangulation_result) {
+            Show<triangulation::DelaunayTriangle>(*triangulation_result, "triangulation", headless);
         } else {
             std::println("Error {}", static_cast<int>(triangulation_result.error()));
         }
     }
 
+    //
+    // Сохраняем результаты замеров, если сборка с GEOMETRY_ENABLE_PROFILING
+    //
+    if constexpr (profiling::kEnabled) {
+        std::ofstream trace{"geometry_trace.json"};
+        profiling::WriteChromeTrace(trace);
+        std::println("\n=== Profiling (trace: geometry_trace.json) ===");
+        profiling::PrintSummary(std::cout);
+    }
+
     return 0;
 }
\ No newline at end of file
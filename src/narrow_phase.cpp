@@ -0,0 +1,271 @@
+#include "narrow_phase.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace geometry::intersections {
+
+NarrowPhase::NarrowPhase(std::span<const Shape> shapes) : records_(shapes.size()) {
+    GEOMETRY_PROFILE_SCOPE("intersections::NarrowPhase");
+
+    for (size_t i = 0; i != shapes.size(); ++i) {
+        Record &record = records_[i];
+        std::visit(
+            [&](const auto &shape) {
+                using T = std::decay_t<decltype(shape)>;
+                if constexpr (std::is_same_v<T, Circle>) {
+                    record.kind = Kind::Circle;
+                    record.center = shape.center_p;
+                    record.radius = std::abs(shape.radius);
+                } else if constexpr (std::is_same_v<T, Line>) {
+                    const std::array points{shape.start, shape.end};
+                    AddOutline(record, points, Kind::Convex);
+                } else if constexpr (std::is_same_v<T, Polygon>) {
+                    AddOutline(record, shape.Points(), Kind::Polygon);
+                } else {
+                    const auto points = shape.Vertices();
+                    AddOutline(record, points, Kind::Convex);
+                }
+            },
+            shapes[i]);
+    }
+}
+
+void NarrowPhase::AddOutline(Record &record, std::span<const Point2D> points, Kind kind) {
+    if (points.empty()) {
+        return;
+    }
+
+    // у вырожденного выпуклого контура разделяющие оси по рёбрам теряют направление вдоль прямой
+    std::array<Point2D, 2> segment;
+    if (kind == Kind::Convex && points.size() > 2) {
+        const auto [min_x, max_x] = std::ranges::minmax(points, {}, &Point2D::x);
+        const auto [min_y, max_y] = std::ranges::minmax(points, {}, &Point2D::y);
+        const double scale = (max_x.x - min_x.x) + (max_y.y - min_y.y);
+        double area = 0;
+        for (size_t i = 1; i + 1 < points.size(); ++i) {
+            area += (points[i] - points[0]).Cross(points[i + 1] - points[0]);
+        }
+        if (std::abs(area) <= 1e-12 * scale * scale) {
+            segment = max_x.x - min_x.x >= max_y.y - min_y.y ? std::array{min_x, max_x} : std::array{min_y, max_y};
+            points = segment;
+        }
+    }
+    // точка -- отрезок нулевой длины
+    if (points.size() == 1) {
+        segment = {points[0], points[0]};
+        points = segment;
+    }
+
+    record.kind = kind;
+    record.closed = points.size() > 2;
+    record.first = static_cast<uint32_t>(xs_.size());
+    record.count = static_cast<uint32_t>(points.size());
+    for (const Point2D p : points) {
+        xs_.push_back(p.x);
+        ys_.push_back(p.y);
+    }
+    if (record.closed) {
+        xs_.push_back(points[0].x);
+        ys_.push_back(points[0].y);
+    }
+}
+
+bool NarrowPhase::Overlaps(uint32_t first, uint32_t second) const noexcept {
+    const Record *lhs = &records_[first];
+    const Record *rhs = &records_[second];
+    if (lhs->kind > rhs->kind) {
+        std::swap(lhs, rhs);
+    }
+
+    if (rhs->kind == Kind::Empty) {
+        return false;
+    }
+    if (lhs->kind == Kind::Circle) {
+        return rhs->kind == Kind::Circle ? CirclesOverlap(*lhs, *rhs) : CircleOutlineOverlap(*lhs, *rhs);
+    }
+    if (rhs->kind == Kind::Convex) {
+        return ConvexOverlap(*lhs, *rhs);
+    }
+    return OutlinesOverlap(*lhs, *rhs);
+}
+
+std::vector<ShapePair> NarrowPhase::Filter(std::span<const ShapePair> candidates) const {
+    GEOMETRY_PROFILE_SCOPE("intersections::NarrowPhase::Filter");
+
+    // пачки по ядрам: окружности, окружность и контур, выпуклые контуры, контуры с Polygon
+    constexpr size_t kBatches = 4;
+    std::array<std::vector<uint32_t>, kBatches> batches;
+    for (uint32_t i = 0; i != candidates.size(); ++i) {
+        auto [lhs, rhs] = std::minmax(records_[candidates[i].first].kind, records_[candidates[i].second].kind);
+        if (rhs == Kind::Empty) {
+            continue;
+        }
+        const size_t batch = lhs == Kind::Circle ? (rhs == Kind::Circle ? 0 : 1) : (rhs == Kind::Convex ? 2 : 3);
+        batches[batch].push_back(i);
+    }
+
+    std::vector<uint8_t> overlaps(candidates.size(), 0);
+    auto check = [&](std::span<const uint32_t> batch, auto kernel) {
+        parallel::ForEachChunk(
+            batch.size(),
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    const auto [first, second] = candidates[batch[i]];
+                    const Record *lhs = &records_[first];
+                    const Record *rhs = &records_[second];
+                    if (lhs->kind > rhs->kind) {
+                        std::swap(lhs, rhs);
+                    }
+                    overlaps[batch[i]] = (this->*kernel)(*lhs, *rhs) ? 1 : 0;
+                }
+            },
+            256);
+    };
+    check(batches[0], &NarrowPhase::CirclesOverlap);
+    check(batches[1], &NarrowPhase::CircleOutlineOverlap);
+    check(batches[2], &NarrowPhase::ConvexOverlap);
+    check(batches[3], &NarrowPhase::OutlinesOverlap);
+
+    std::vector<ShapePair> res;
+    for (size_t i = 0; i != candidates.size(); ++i) {
+        if (overlaps[i] != 0) {
+            res.push_back(candidates[i]);
+        }
+    }
+    return res;
+}
+
+bool NarrowPhase::CirclesOverlap(const Record &lhs, const Record &rhs) const noexcept {
+    GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+    const Point2D d = lhs.center - rhs.center;
+    const double radius = lhs.radius + rhs.radius;
+    return d.Dot(d) <= radius * radius;
+}
+
+bool NarrowPhase::CircleOutlineOverlap(const Record &circle, const Record &outline) const noexcept {
+    GEOMETRY_PROFILE_COUNT(PredicateEvaluations, outline.Edges());
+    const double cx = circle.center.x;
+    const double cy = circle.center.y;
+
+    // квадрат расстояния от центра до ближайшей точки рёбер
+    double distance2 = std::numeric_limits<double>::infinity();
+    for (uint32_t i = outline.first; i != outline.first + outline.Edges(); ++i) {
+        const double ex = xs_[i + 1] - xs_[i];
+        const double ey = ys_[i + 1] - ys_[i];
+        const double wx = cx - xs_[i];
+        const double wy = cy - ys_[i];
+        const double length2 = ex * ex + ey * ey;
+        const double t = std::clamp((wx * ex + wy * ey) / (length2 > 0 ? length2 : 1), 0.0, 1.0);
+        const double dx = wx - ex * t;
+        const double dy = wy - ey * t;
+        distance2 = std::min(distance2, dx * dx + dy * dy);
+    }
+    // иначе окружность целиком внутри контура или снаружи
+    return distance2 <= circle.radius * circle.radius || Contains(outline, circle.center);
+}
+
+bool NarrowPhase::ConvexOverlap(const Record &lhs, const Record &rhs) const noexcept {
+    GEOMETRY_PROFILE_COUNT(PredicateEvaluations, lhs.Edges() + rhs.Edges());
+    // оси координат -- проверка прямоугольников; заодно разделяют точки, у которых нет своих осей
+    if (!ProjectionsOverlap(lhs, rhs, {1, 0}) || !ProjectionsOverlap(lhs, rhs, {0, 1})) {
+        return false;
+    }
+
+    for (const Record *record : {&lhs, &rhs}) {
+        for (uint32_t i = record->first; i != record->first + record->Edges(); ++i) {
+            const Point2D edge{xs_[i + 1] - xs_[i], ys_[i + 1] - ys_[i]};
+            if (!ProjectionsOverlap(lhs, rhs, {-edge.y, edge.x})) {
+                return false;
+            }
+            // у отрезка ещё ось вдоль него: разделяет отрезки на одной прямой
+            if (!record->closed && !ProjectionsOverlap(lhs, rhs, edge)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool NarrowPhase::OutlinesOverlap(const Record &lhs, const Record &rhs) const noexcept {
+    GEOMETRY_PROFILE_COUNT(PredicateEvaluations, lhs.Edges() * rhs.Edges());
+    for (uint32_t i = lhs.first; i != lhs.first + lhs.Edges(); ++i) {
+        const double ax = xs_[i];
+        const double ay = ys_[i];
+        const double aex = xs_[i + 1] - ax;
+        const double aey = ys_[i + 1] - ay;
+        const double a_min_x = std::min(ax, xs_[i + 1]);
+        const double a_max_x = std::max(ax, xs_[i + 1]);
+        const double a_min_y = std::min(ay, ys_[i + 1]);
+        const double a_max_y = std::max(ay, ys_[i + 1]);
+
+        // концы каждого отрезка по разные стороны (или на) прямой другого; у коллинеарных отрезков
+        // все знаки нулевые, и пересечение решают прямоугольники
+        bool crossing = false;
+        for (uint32_t j = rhs.first; j != rhs.first + rhs.Edges(); ++j) {
+            const double bx = xs_[j];
+            const double by = ys_[j];
+            const double bex = xs_[j + 1] - bx;
+            const double bey = ys_[j + 1] - by;
+            const double d1 = bex * (ay - by) - bey * (ax - bx);
+            const double d2 = bex * (ay + aey - by) - bey * (ax + aex - bx);
+            const double d3 = aex * (by - ay) - aey * (bx - ax);
+            const double d4 = aex * (by + bey - ay) - aey * (bx + bex - ax);
+            const bool boxes = (std::min(bx, bx + bex) <= a_max_x) & (a_min_x <= std::max(bx, bx + bex)) &
+                               (std::min(by, by + bey) <= a_max_y) & (a_min_y <= std::max(by, by + bey));
+            crossing |= (d1 * d2 <= 0) & (d3 * d4 <= 0) & boxes;
+        }
+        if (crossing) {
+            return true;
+        }
+    }
+
+    // рёбра не пересекаются: либо один контур внутри другого, либо они не пересекаются вовсе
+    return Contains(lhs, {xs_[rhs.first], ys_[rhs.first]}) || Contains(rhs, {xs_[lhs.first], ys_[lhs.first]});
+}
+
+bool NarrowPhase::Contains(const Record &outline, Point2D p) const noexcept {
+    if (!outline.closed) {
+        return false;
+    }
+
+    // чётность пересечений горизонтального луча из p вправо
+    bool inside = false;
+    for (uint32_t i = outline.first; i != outline.first + outline.Edges(); ++i) {
+        const double x0 = xs_[i];
+        const double y0 = ys_[i];
+        const double ex = xs_[i + 1] - x0;
+        const double ey = ys_[i + 1] - y0;
+        const bool spans = (y0 > p.y) != (y0 + ey > p.y);
+        const double x = x0 + (p.y - y0) * ex / (ey != 0 ? ey : 1);
+        inside ^= spans & (p.x < x);
+    }
+    return inside;
+}
+
+bool NarrowPhase::ProjectionsOverlap(const Record &lhs, const Record &rhs, Point2D axis) const noexcept {
+    auto project = [&](const Record &record) {
+        double min = std::numeric_limits<double>::infinity();
+        double max = -min;
+        for (uint32_t i = record.first; i != record.first + record.count; ++i) {
+            const double v = xs_[i] * axis.x + ys_[i] * axis.y;
+            min = std::min(min, v);
+            max = std::max(max, v);
+        }
+        return std::pair{min, max};
+    };
+    const auto [lhs_min, lhs_max] = project(lhs);
+    const auto [rhs_min, rhs_max] = project(rhs);
+    return lhs_min <= rhs_max && rhs_min <= lhs_max;
+}
+
+bool ShapesOverlap(const Shape &lhs, const Shape &rhs) {
+    const std::array shapes{lhs, rhs};
+    return NarrowPhase{shapes}.Overlaps(0, 1);
+}
+
+}  // namespace geometry::intersections
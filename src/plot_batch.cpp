@@ -0,0 +1,189 @@
+#include "plot_batch.hpp"
+#include "queries.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geometry::visualization {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+template <typename T, typename... Ts>
+constexpr size_t KindIndex(const std::variant<Ts...> *) {
+    size_t index = 0;
+    static_cast<void>(((std::is_same_v<T, Ts> ? false : (++index, true)) && ...));
+    return index;
+}
+
+template <typename T>
+constexpr size_t kKindOf = KindIndex<T>(static_cast<const Shape *>(nullptr));
+
+// контур из count вершин, замкнутый при closed, и разрыв NaN после него
+template <typename VertexAt>
+void AppendOutline(Lines2DDyn &out, size_t count, bool closed, VertexAt &&vertex_at) {
+    for (size_t i = 0; i != count; ++i) {
+        out.PushBack(vertex_at(i));
+    }
+    if (closed && count != 0) {
+        out.PushBack(vertex_at(0));
+    }
+    out.PushBack(kNaN, kNaN);
+}
+
+// выходной итератор, дописывающий точки в Lines2DDyn
+class LinesInserter {
+public:
+    using difference_type = std::ptrdiff_t;
+
+    explicit LinesInserter(Lines2DDyn &lines) : lines_{&lines} {}
+
+    LinesInserter &operator=(const Point2D &p) {
+        lines_->PushBack(p);
+        return *this;
+    }
+    LinesInserter &operator*() { return *this; }
+    LinesInserter &operator++() { return *this; }
+    LinesInserter &operator++(int) { return *this; }
+
+private:
+    Lines2DDyn *lines_;
+};
+
+class OutlineAppender {
+public:
+    OutlineAppender(Lines2DDyn &out, const BatchOptions &options) : out_{out}, options_{options} {}
+
+    void operator()(const Line &line) const {
+        const auto pts = line.Vertices();
+        AppendOutline(out_, pts.size(), false, [&pts](size_t i) { return pts[i]; });
+    }
+
+    void operator()(const Triangle &tri) const {
+        const auto pts = tri.Vertices();
+        AppendOutline(out_, pts.size(), true, [&pts](size_t i) { return pts[i]; });
+    }
+
+    void operator()(const Rectangle &rect) const {
+        const auto pts = rect.Vertices();
+        AppendOutline(out_, pts.size(), true, [&pts](size_t i) { return pts[i]; });
+    }
+
+    void operator()(const RegularPolygon &poly) const {
+        if (poly.sides != 0) {
+            GenerateCirclePoints(poly.center_p, poly.radius, 0.0, static_cast<size_t>(poly.sides), LinesInserter{out_});
+            out_.PushBack(poly.Vertex(0));
+        }
+        out_.PushBack(kNaN, kNaN);
+    }
+
+    void operator()(const Circle &circle) const {
+        const double r = std::abs(circle.radius);
+        GenerateCirclePoints(circle.center_p, r, 0.0, CircleSegments(r, options_), LinesInserter{out_});
+        out_.PushBack(circle.center_p.x + r, circle.center_p.y);
+        out_.PushBack(kNaN, kNaN);
+    }
+
+    void operator()(const Polygon &poly) const {
+        const auto pts = poly.Points();
+        AppendOutline(out_, pts.size(), true, [&pts](size_t i) { return pts[i]; });
+    }
+
+private:
+    Lines2DDyn &out_;
+    const BatchOptions &options_;
+};
+
+std::vector<Label> DecimateLabels(size_t count, size_t max_labels, auto &&center_at) {
+    std::vector<Label> labels;
+    if (max_labels == 0 || count == 0) {
+        return labels;
+    }
+
+    const size_t step = (count + max_labels - 1) / max_labels;
+    labels.reserve(count / step + 1);
+    for (size_t i = 0; i < count; i += step) {
+        labels.push_back({center_at(i), i});
+    }
+    return labels;
+}
+
+}  // namespace
+
+BoundingBox SceneBoundBox(std::span<const Shape> shapes) {
+    if (shapes.empty()) {
+        return {0.0, 0.0, 0.0, 0.0};
+    }
+
+    auto res = queries::GetBoundBox(shapes.front());
+    for (const auto &shape : shapes.subspan(1)) {
+        const auto bb = queries::GetBoundBox(shape);
+        res.min_x = std::min(res.min_x, bb.min_x);
+        res.min_y = std::min(res.min_y, bb.min_y);
+        res.max_x = std::max(res.max_x, bb.max_x);
+        res.max_y = std::max(res.max_y, bb.max_y);
+    }
+    return res;
+}
+
+double PixelSize(const BoundingBox &scene, size_t pixels) {
+    if (pixels == 0) {
+        return 0.0;
+    }
+    return std::max(scene.Width(), scene.Height()) / static_cast<double>(pixels);
+}
+
+size_t CircleSegments(double radius, const BatchOptions &options) {
+    // меньше трёх сегментов -- не контур: max_circle_segments == 0 дал бы одну замыкающую точку
+    const size_t max_segments = std::max<size_t>(options.max_circle_segments, 3);
+    if (options.pixel_size <= 0.0) {
+        return max_segments;
+    }
+
+    const size_t min_segments = std::clamp<size_t>(options.min_circle_segments, 3, max_segments);
+    return SegmentsForChordError(radius, {options.pixel_size * options.chord_error_pixels}, min_segments,
+                                 max_segments);
+}
+
+ShapeBatches BuildShapeBatches(std::span<const Shape> shapes, const BatchOptions &options) {
+    ShapeBatches res;
+
+    for (const auto &shape : shapes) {
+        const size_t kind = shape.index();
+
+        if (options.pixel_size > 0.0) {
+            const auto bb = queries::GetBoundBox(shape);
+            if (bb.Width() < options.pixel_size && bb.Height() < options.pixel_size) {
+                res.points[kind].PushBack(bb.Center());
+                continue;
+            }
+        }
+
+        std::visit(OutlineAppender{res.outlines[kind], options}, shape);
+    }
+
+    res.labels = DecimateLabels(shapes.size(), options.max_labels, [&shapes](size_t i) {
+        return std::visit([](const auto &s) { return s.Center(); }, shapes[i]);
+    });
+    return res;
+}
+
+ShapeBatches BuildTriangleBatches(std::span<const triangulation::DelaunayTriangle> triangles,
+                                  const BatchOptions &options) {
+    ShapeBatches res;
+
+    auto &outline = res.outlines[kKindOf<Triangle>];
+    outline.Reserve(triangles.size() * 5);
+    for (const auto &t : triangles) {
+        const std::array<Point2D, 3> pts{t.a, t.b, t.c};
+        AppendOutline(outline, pts.size(), true, [&pts](size_t i) { return pts[i]; });
+    }
+
+    res.labels = DecimateLabels(triangles.size(), options.max_labels, [&triangles](size_t i) {
+        return Triangle{triangles[i].a, triangles[i].b, triangles[i].c}.Center();
+    });
+    return res;
+}
+
+}  // namespace geometry::visualization
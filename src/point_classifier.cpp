@@ -0,0 +1,269 @@
+#include "point_classifier.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geometry::queries {
+
+namespace {
+
+constexpr size_t kNoCell = std::numeric_limits<size_t>::max();
+
+// отрезок ab задевает замкнутый прямоугольник box (отсечение Лианга-Барски)
+bool SegmentTouchesBox(Point2D a, Point2D b, const BoundingBox &box) {
+    const Point2D d = b - a;
+    double t0 = 0;
+    double t1 = 1;
+    // допустимые t: p * t <= q
+    auto clip = [&](double p, double q) {
+        if (p == 0) {
+            return q >= 0;
+        }
+        const double t = q / p;
+        if (p < 0) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        return t0 <= t1;
+    };
+    return clip(-d.x, a.x - box.min_x) && clip(d.x, box.max_x - a.x) && clip(-d.y, a.y - box.min_y) &&
+           clip(d.y, box.max_y - a.y);
+}
+
+}  // namespace
+
+RegionClassifier::RegionClassifier(std::span<const Polygon> regions) {
+    GEOMETRY_PROFILE_SCOPE("queries::RegionClassifier");
+
+    BuildSlabs(regions);
+    BuildGrid(regions);
+}
+
+void RegionClassifier::BuildSlabs(std::span<const Polygon> regions) {
+    regions_.resize(regions.size());
+    slab_offsets_ = {0};
+
+    std::vector<uint32_t> cursor;
+    for (size_t r = 0; r != regions.size(); ++r) {
+        const auto points = regions[r].Points();
+        auto &region = regions_[r];
+        region.first_slab = static_cast<uint32_t>(slab_offsets_.size() - 1);
+        if (points.size() < 3) {
+            continue;
+        }
+
+        // около четырёх рёбер на полосу
+        const BoundingBox box = regions[r].BoundBox();
+        region.min_y = box.min_y;
+        region.slabs_count = static_cast<uint32_t>(std::clamp<size_t>(points.size() / kLanes, 1, 4096));
+        region.inverse_height = box.Height() > 0 ? region.slabs_count / box.Height() : 0.0;
+
+        // ребро попадает во все полосы, которые задевает его проекция на y
+        auto for_each_edge = [&](auto &&f) {
+            for (size_t i = 0; i != points.size(); ++i) {
+                const Point2D cur = points[i];
+                const Point2D prev = points[(i + points.size() - 1) % points.size()];
+                const uint32_t first = SlabOf(region, std::min(cur.y, prev.y));
+                const uint32_t last = SlabOf(region, std::max(cur.y, prev.y));
+                for (uint32_t s = first; s <= last; ++s) {
+                    f(s, cur, prev);
+                }
+            }
+        };
+
+        cursor.assign(region.slabs_count, 0);
+        for_each_edge([&](uint32_t s, Point2D, Point2D) { ++cursor[s]; });
+
+        // полосы дополнены горизонтальными рёбрами (0, 0) -- (0, 0), которые ничего не пересекают
+        size_t offset = x0_.size();
+        for (uint32_t s = 0; s != region.slabs_count; ++s) {
+            const size_t count = (cursor[s] + kLanes - 1) / kLanes * kLanes;
+            cursor[s] = static_cast<uint32_t>(offset);
+            offset += count;
+            slab_offsets_.push_back(static_cast<uint32_t>(offset));
+        }
+        x0_.resize(offset, 0.0);
+        y0_.resize(offset, 0.0);
+        x1_.resize(offset, 0.0);
+        y1_.resize(offset, 0.0);
+
+        for_each_edge([&](uint32_t s, Point2D cur, Point2D prev) {
+            const uint32_t i = cursor[s]++;
+            x0_[i] = cur.x;
+            y0_[i] = cur.y;
+            x1_[i] = prev.x;
+            y1_[i] = prev.y;
+        });
+    }
+}
+
+void RegionClassifier::BuildGrid(std::span<const Polygon> regions) {
+    size_t edges = 0;
+    bool first = true;
+    for (size_t r = 0; r != regions.size(); ++r) {
+        if (regions_[r].slabs_count == 0) {
+            continue;
+        }
+        const BoundingBox box = regions[r].BoundBox();
+        box_ = first ? box
+                     : BoundingBox{std::min(box_.min_x, box.min_x), std::min(box_.min_y, box.min_y),
+                                   std::max(box_.max_x, box.max_x), std::max(box_.max_y, box.max_y)};
+        first = false;
+        edges += regions[r].Points().size();
+    }
+    if (first) {
+        return;
+    }
+
+    // около двух клеток на ребро
+    const double cells = static_cast<double>(std::clamp<size_t>(2 * edges, 1, size_t{1} << 22));
+    const double width = box_.Width();
+    const double height = box_.Height();
+    cell_ = std::max({std::sqrt(width * height / cells), std::max(width, height) / cells,
+                      std::numeric_limits<double>::min()});
+    columns_ = static_cast<size_t>(width / cell_) + 1;
+    rows_ = static_cast<size_t>(height / cell_) + 1;
+
+    auto column_of = [this](double x) {
+        return std::min(static_cast<size_t>(std::max(0.0, (x - box_.min_x) / cell_)), columns_ - 1);
+    };
+    auto row_of = [this](double y) {
+        return std::min(static_cast<size_t>(std::max(0.0, (y - box_.min_y) / cell_)), rows_ - 1);
+    };
+
+    // пары (клетка, регион), регионы по возрастанию номера
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    std::vector<uint8_t> boundary;
+    for (size_t r = 0; r != regions.size(); ++r) {
+        if (regions_[r].slabs_count == 0) {
+            continue;
+        }
+
+        const BoundingBox box = regions[r].BoundBox();
+        const size_t c0 = column_of(box.min_x);
+        const size_t c1 = column_of(box.max_x);
+        const size_t r0 = row_of(box.min_y);
+        const size_t r1 = row_of(box.max_y);
+        const size_t span_columns = c1 - c0 + 1;
+        boundary.assign(span_columns * (r1 - r0 + 1), 0);
+
+        // клетки, которые задевает граница; прямоугольник клетки слегка расширен против ошибок округления
+        const double margin = cell_ * 1e-6;
+        const auto points = regions[r].Points();
+        for (size_t i = 0; i != points.size(); ++i) {
+            const Point2D a = points[i];
+            const Point2D b = points[(i + 1) % points.size()];
+            const size_t first_row = std::max(r0, row_of(std::min(a.y, b.y) - margin));
+            const size_t last_row = std::min(r1, row_of(std::max(a.y, b.y) + margin));
+            const size_t first_column = std::max(c0, column_of(std::min(a.x, b.x) - margin));
+            const size_t last_column = std::min(c1, column_of(std::max(a.x, b.x) + margin));
+            for (size_t row = first_row; row <= last_row; ++row) {
+                for (size_t column = first_column; column <= last_column; ++column) {
+                    uint8_t &mark = boundary[(row - r0) * span_columns + (column - c0)];
+                    if (mark == 0) {
+                        BoundingBox cell = CellBox(column, row);
+                        cell = {cell.min_x - margin, cell.min_y - margin, cell.max_x + margin, cell.max_y + margin};
+                        mark = SegmentTouchesBox(a, b, cell) ? 1 : 0;
+                    }
+                }
+            }
+        }
+
+        // клетка без границы целиком внутри или целиком снаружи, как её центр
+        for (size_t row = r0; row <= r1; ++row) {
+            for (size_t column = c0; column <= c1; ++column) {
+                const auto cell = static_cast<uint32_t>(row * columns_ + column);
+                const auto region = static_cast<uint32_t>(r);
+                if (boundary[(row - r0) * span_columns + (column - c0)] != 0) {
+                    entries.emplace_back(cell, region);
+                } else if (Contains(region, CellBox(column, row).Center())) {
+                    entries.emplace_back(cell, region | kInside);
+                }
+            }
+        }
+    }
+
+    // устойчивая сортировка подсчётом по клеткам
+    cell_offsets_.assign(columns_ * rows_ + 1, 0);
+    for (const auto &[cell, _] : entries) {
+        ++cell_offsets_[cell + 1];
+    }
+    for (size_t i = 1; i != cell_offsets_.size(); ++i) {
+        cell_offsets_[i] += cell_offsets_[i - 1];
+    }
+    cell_entries_.resize(entries.size());
+    std::vector<uint32_t> cursor(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    for (const auto &[cell, value] : entries) {
+        cell_entries_[cursor[cell]++] = value;
+    }
+}
+
+uint32_t RegionClassifier::SlabOf(const RegionSlabs &region, double y) const noexcept {
+    const double s = (y - region.min_y) * region.inverse_height;
+    return static_cast<uint32_t>(std::clamp(s, 0.0, static_cast<double>(region.slabs_count - 1)));
+}
+
+bool RegionClassifier::Contains(uint32_t region, Point2D p) const noexcept {
+    const auto &slabs = regions_[region];
+    const uint32_t s = slabs.first_slab + SlabOf(slabs, p.y);
+
+    // без ветвлений: пересечение засчитывается арифметически, горизонтальные рёбра дают NaN и false
+    uint32_t crossings = 0;
+    for (uint32_t i = slab_offsets_[s]; i != slab_offsets_[s + 1]; ++i) {
+        const bool straddles = (y0_[i] > p.y) != (y1_[i] > p.y);
+        const double x = (x1_[i] - x0_[i]) * (p.y - y0_[i]) / (y1_[i] - y0_[i]) + x0_[i];
+        crossings += static_cast<uint32_t>(straddles & (p.x < x));
+    }
+    return (crossings & 1) != 0;
+}
+
+size_t RegionClassifier::CellOf(Point2D p) const noexcept {
+    // отрицание сравнений отсекает и NaN
+    if (columns_ == 0 || !(p.x >= box_.min_x && p.x <= box_.max_x && p.y >= box_.min_y && p.y <= box_.max_y)) {
+        return kNoCell;
+    }
+    const size_t column = std::min(static_cast<size_t>((p.x - box_.min_x) / cell_), columns_ - 1);
+    const size_t row = std::min(static_cast<size_t>((p.y - box_.min_y) / cell_), rows_ - 1);
+    return row * columns_ + column;
+}
+
+BoundingBox RegionClassifier::CellBox(size_t column, size_t row) const noexcept {
+    const double x = box_.min_x + static_cast<double>(column) * cell_;
+    const double y = box_.min_y + static_cast<double>(row) * cell_;
+    return {x, y, x + cell_, y + cell_};
+}
+
+uint32_t RegionClassifier::Classify(Point2D p) const noexcept {
+    const size_t cell = CellOf(p);
+    if (cell == kNoCell) {
+        return kNoRegion;
+    }
+
+    for (uint32_t k = cell_offsets_[cell]; k != cell_offsets_[cell + 1]; ++k) {
+        const uint32_t entry = cell_entries_[k];
+        if ((entry & kInside) != 0) {
+            return entry & ~kInside;
+        }
+        if (Contains(entry, p)) {
+            return entry;
+        }
+    }
+    return kNoRegion;
+}
+
+std::vector<uint32_t> RegionClassifier::Classify(std::span<const Point2D> points) const {
+    GEOMETRY_PROFILE_SCOPE("queries::RegionClassifier::Classify");
+
+    std::vector<uint32_t> res(points.size());
+    parallel::ForEachChunk(points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i != end; ++i) {
+            res[i] = Classify(points[i]);
+        }
+    });
+    return res;
+}
+
+}  // namespace geometry::queries
@@ -0,0 +1,198 @@
+#include "point_location.hpp"
+#include "convex_hull.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include "spatial_sort.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geometry::triangulation {
+
+PointLocator::PointLocator(const DelaunayMesh &mesh, size_t landmarks) : mesh_{mesh} {
+    const size_t vertices = mesh_.Vertices().size();
+    if (landmarks == 0) {
+        landmarks = static_cast<size_t>(std::cbrt(static_cast<double>(vertices))) + 1;
+    }
+    landmarks = std::min(landmarks, vertices);
+
+    // равномерная выборка по номерам; изолированные вершины (повторы) пропускаются
+    landmark_points_.reserve(landmarks);
+    landmark_triangles_.reserve(landmarks);
+    for (size_t i = 0; i != landmarks; ++i) {
+        const auto v = static_cast<uint32_t>(i * vertices / landmarks);
+        const uint32_t edge = mesh_.OutgoingEdge(v);
+        if (edge != kNoIndex) {
+            landmark_points_.push_back(mesh_.Vertex(v));
+            landmark_triangles_.push_back(DelaunayMesh::TriangleOf(edge));
+        }
+    }
+
+    if (auto hull = convex_hull::GrahamScan(mesh_.Vertices())) {
+        hull_ = std::move(*hull);
+    }
+}
+
+uint32_t PointLocator::Locate(Point2D p) const {
+    if (landmark_triangles_.empty()) {
+        return kNoIndex;
+    }
+    return Walk(NearestLandmark(p), p);
+}
+
+uint32_t PointLocator::Locate(Point2D p, uint32_t hint) const {
+    if (hint >= mesh_.TrianglesCount()) {
+        return Locate(p);
+    }
+    return Walk(hint, p);
+}
+
+std::vector<uint32_t> PointLocator::Locate(std::span<const Point2D> queries) const {
+    GEOMETRY_PROFILE_SCOPE("triangulation::PointLocator::Locate");
+
+    std::vector<uint32_t> res(queries.size(), kNoIndex);
+    if (landmark_triangles_.empty()) {
+        return res;
+    }
+
+    const auto order = spatial::HilbertOrder(queries);
+    parallel::ForEachChunk(order.size(), [&](size_t begin, size_t end) {
+        uint32_t previous = kNoIndex;
+        for (size_t i = begin; i != end; ++i) {
+            const Point2D p = queries[order[i]];
+            const uint32_t start = previous != kNoIndex ? previous : NearestLandmark(p);
+            const uint32_t found = Walk(start, p);
+            res[order[i]] = found;
+            previous = found;
+        }
+    });
+    return res;
+}
+
+uint32_t PointLocator::NearestLandmark(Point2D p) const {
+    size_t best = 0;
+    double best_distance = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i != landmark_points_.size(); ++i) {
+        const Point2D d = landmark_points_[i] - p;
+        const double distance = d.x * d.x + d.y * d.y;
+        if (distance < best_distance) {
+            best_distance = distance;
+            best = i;
+        }
+    }
+    return landmark_triangles_[best];
+}
+
+bool PointLocator::OutsideHull(Point2D p) const {
+    for (size_t i = 0; i != hull_.size(); ++i) {
+        const Point2D a = hull_[i];
+        const Point2D b = hull_[(i + 1) % hull_.size()];
+        if ((b - a).Cross(p - a) < 0) {
+            return true;
+        }
+    }
+    return hull_.empty();
+}
+
+Point2D PointLocator::Centroid(uint32_t triangle) const {
+    const auto &[a, b, c] = mesh_.Triangles()[triangle];
+    const Point2D pa = mesh_.Vertex(a);
+    const Point2D pb = mesh_.Vertex(b);
+    const Point2D pc = mesh_.Vertex(c);
+    return {(pa.x + pb.x + pc.x) / 3, (pa.y + pb.y + pc.y) / 3};
+}
+
+uint32_t PointLocator::LastBoundaryCrossing(Point2D from, Point2D to) const {
+    const Point2D d = to - from;
+    uint32_t res = kNoIndex;
+    double best = -1.0;
+    for (const uint32_t h : mesh_.BoundaryEdges()) {
+        const Point2D a = mesh_.Vertex(mesh_.Origin(h));
+        const Point2D e = mesh_.Vertex(mesh_.Target(h)) - a;
+        const double denominator = d.Cross(e);
+        if (denominator == 0) {
+            continue;
+        }
+        const double t = (a - from).Cross(e) / denominator;
+        const double s = (a - from).Cross(d) / denominator;
+        if (t >= 0 && t <= 1 && s >= 0 && s <= 1 && t > best) {
+            best = t;
+            res = h;
+        }
+    }
+    return res;
+}
+
+uint32_t PointLocator::Scan(Point2D p) const {
+    for (uint32_t t = 0; t != mesh_.TrianglesCount(); ++t) {
+        bool inside = true;
+        for (uint32_t h = 3 * t; h != 3 * t + 3 && inside; ++h) {
+            const Point2D a = mesh_.Vertex(mesh_.Origin(h));
+            const Point2D b = mesh_.Vertex(mesh_.Target(h));
+            inside = (b - a).Cross(p - a) >= 0;
+        }
+        if (inside) {
+            return t;
+        }
+    }
+    return kNoIndex;
+}
+
+uint32_t PointLocator::Walk(uint32_t triangle, Point2D p) const {
+    // ребро, через которое вошли, повторно не проверяется
+    uint32_t entry = kNoIndex;
+    bool reentered = false;
+    for (size_t steps = 0; steps <= mesh_.TrianglesCount(); ++steps) {
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+
+        // при нескольких вариантах предпочитается внутреннее ребро
+        uint32_t exit = kNoIndex;
+        for (uint32_t h = 3 * triangle; h != 3 * triangle + 3; ++h) {
+            if (h == entry) {
+                continue;
+            }
+            const Point2D a = mesh_.Vertex(mesh_.Origin(h));
+            const Point2D b = mesh_.Vertex(mesh_.Target(h));
+            if ((b - a).Cross(p - a) < 0) {
+                exit = h;
+                if (mesh_.Twin(h) != kNoIndex) {
+                    break;
+                }
+            }
+        }
+
+        if (exit == kNoIndex) {
+            return triangle;
+        }
+        entry = mesh_.Twin(exit);
+        if (entry != kNoIndex) {
+            triangle = DelaunayMesh::TriangleOf(entry);
+            continue;
+        }
+
+        // упёрлись в границу: либо точка снаружи, либо за вогнутостью границы
+        if (OutsideHull(p)) {
+            return kNoIndex;
+        }
+        if (reentered) {
+            return Scan(p);
+        }
+        const uint32_t edge = LastBoundaryCrossing(Centroid(triangle), p);
+        if (edge == kNoIndex) {
+            return Scan(p);
+        }
+        const Point2D a = mesh_.Vertex(mesh_.Origin(edge));
+        const Point2D b = mesh_.Vertex(mesh_.Target(edge));
+        if ((b - a).Cross(p - a) < 0) {
+            // последнее пересечение отрезка с границей -- выход из триангуляции
+            return kNoIndex;
+        }
+        reentered = true;
+        entry = edge;
+        triangle = DelaunayMesh::TriangleOf(edge);
+    }
+    // лимит шагов исчерпан -- текущий треугольник не обязан содержать точку
+    return Scan(p);
+}
+
+}  // namespace geometry::triangulation
@@ -0,0 +1,127 @@
+#include "polygon_soa.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace geometry {
+
+namespace {
+
+using Lanes = std::array<double, PolygonSoA::kLanes>;
+
+double Sum(const Lanes &lanes) {
+    double res = 0;
+    for (const double v : lanes) {
+        res += v;
+    }
+    return res;
+}
+
+}  // namespace
+
+PolygonSoA::PolygonSoA(std::span<const Point2D> points) : size_{points.size()} {
+    if (points.empty()) {
+        return;
+    }
+
+    const size_t padded = (size_ + kLanes - 1) / kLanes * kLanes + 1;
+    xs_.resize(padded, points[0].x);
+    ys_.resize(padded, points[0].y);
+    for (size_t i = 0; i != size_; ++i) {
+        xs_[i] = points[i].x;
+        ys_[i] = points[i].y;
+    }
+
+    // дополнение повторяет первую вершину и не меняет минимумов и максимумов
+    Lanes min_x;
+    Lanes min_y;
+    Lanes max_x;
+    Lanes max_y;
+    min_x.fill(points[0].x);
+    max_x.fill(points[0].x);
+    min_y.fill(points[0].y);
+    max_y.fill(points[0].y);
+    for (size_t i = 0; i + kLanes < padded; i += kLanes) {
+        for (size_t j = 0; j != kLanes; ++j) {
+            min_x[j] = std::min(min_x[j], xs_[i + j]);
+            max_x[j] = std::max(max_x[j], xs_[i + j]);
+            min_y[j] = std::min(min_y[j], ys_[i + j]);
+            max_y[j] = std::max(max_y[j], ys_[i + j]);
+        }
+    }
+    bounding_box_ = {std::ranges::min(min_x), std::ranges::min(min_y), std::ranges::max(max_x),
+                     std::ranges::max(max_y)};
+}
+
+PolygonMetrics PolygonSoA::Metrics() const noexcept {
+    if (size_ == 0) {
+        return {};
+    }
+
+    // координаты относительно первой вершины: меньше потеря точности в произведениях
+    const double x0 = xs_[0];
+    const double y0 = ys_[0];
+
+    Lanes area{};
+    Lanes cx{};
+    Lanes cy{};
+    Lanes perimeter{};
+    Lanes sum_x{};
+    Lanes sum_y{};
+    for (size_t i = 0; i + 1 < xs_.size(); i += kLanes) {
+        for (size_t j = 0; j != kLanes; ++j) {
+            const double ax = xs_[i + j] - x0;
+            const double ay = ys_[i + j] - y0;
+            const double bx = xs_[i + j + 1] - x0;
+            const double by = ys_[i + j + 1] - y0;
+            const double cross = ax * by - bx * ay;
+            area[j] += cross;
+            cx[j] += (ax + bx) * cross;
+            cy[j] += (ay + by) * cross;
+            perimeter[j] += std::sqrt((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+            sum_x[j] += ax;
+            sum_y[j] += ay;
+        }
+    }
+
+    PolygonMetrics res;
+    res.signed_area = Sum(area) / 2;
+    res.perimeter = Sum(perimeter);
+
+    // вырожденность -- относительно размера кольца: у почти коллинеарного кольца площадь -- шум округления
+    const double twice_area = 2 * res.signed_area;
+    const double extent = std::max(bounding_box_.Width(), bounding_box_.Height());
+    if (std::abs(twice_area) > ScalarTraits<double>::kEpsilon * extent * extent) {
+        res.centroid = {x0 + Sum(cx) / (3 * twice_area), y0 + Sum(cy) / (3 * twice_area)};
+        res.winding = res.signed_area > 0 ? Winding::CounterClockwise : Winding::Clockwise;
+    } else {
+        // дополнение состоит из нулей относительно первой вершины
+        const auto n = static_cast<double>(size_);
+        res.centroid = {x0 + Sum(sum_x) / n, y0 + Sum(sum_y) / n};
+    }
+    return res;
+}
+
+Polygon PolygonSoA::ToPolygon() const {
+    std::vector<Point2D> points(size_);
+    for (size_t i = 0; i != size_; ++i) {
+        points[i] = Vertex(i);
+    }
+    return Polygon{std::move(points)};
+}
+
+std::vector<PolygonMetrics> Metrics(std::span<const PolygonSoA> polygons) {
+    GEOMETRY_PROFILE_SCOPE("geometry::Metrics");
+
+    std::vector<PolygonMetrics> res(polygons.size());
+    parallel::ForEachChunk(polygons.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i != end; ++i) {
+            res[i] = polygons[i].Metrics();
+        }
+    });
+    return res;
+}
+
+}  // namespace geometry
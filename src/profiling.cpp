@@ -0,0 +1,196 @@
+#include "profiling.hpp"
+#include <algorithm>
+#include <format>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace geometry::profiling {
+
+namespace {
+
+const auto kStartTime = std::chrono::steady_clock::now();
+
+class Registry {
+public:
+    static Registry &Instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadBuffer &Register() {
+        std::lock_guard lock{mutex_};
+        // буферы живут до конца программы, чтобы события завершившихся потоков попали в отчёт
+        buffers_.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(buffers_.size())));
+        return *buffers_.back();
+    }
+
+    uint32_t RegisterScope(const char *name) {
+        std::lock_guard lock{mutex_};
+        const size_t count = scopes_count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i != count; ++i) {
+            if (std::string_view{scope_names_[i]} == name) {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        // последний слот -- общий для всех имён сверх таблицы
+        if (count + 1 == kMaxScopes) {
+            scope_names_[count] = "(other scopes)";
+        } else if (count == kMaxScopes) {
+            return kMaxScopes - 1;
+        } else {
+            scope_names_[count] = name;
+        }
+        scopes_count_.store(count + 1, std::memory_order_release);
+        return static_cast<uint32_t>(count);
+    }
+
+    size_t ScopesCount() const noexcept { return scopes_count_.load(std::memory_order_acquire); }
+    std::string_view ScopeName(uint32_t scope) const noexcept { return scope_names_[scope]; }
+
+    template <typename F>
+    void ForEach(F &&f) {
+        std::lock_guard lock{mutex_};
+        for (const auto &buffer : buffers_) {
+            f(*buffer);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    // имена пишутся до увеличения счётчика, поэтому читаются без мьютекса
+    std::array<const char *, kMaxScopes> scope_names_{};
+    std::atomic<size_t> scopes_count_{0};
+};
+
+void WriteJsonString(std::ostream &out, std::string_view str) {
+    out << '"';
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+}  // namespace
+
+std::string_view CounterName(Counter counter) noexcept {
+    switch (counter) {
+    case Counter::PredicateEvaluations:
+        return "predicate evaluations";
+    case Counter::CandidatePairs:
+        return "candidate pairs";
+    case Counter::TrianglesVisited:
+        return "triangles visited";
+    case Counter::Count:
+        break;
+    }
+    return "unknown";
+}
+
+uint32_t RegisterScope(const char *name) { return Registry::Instance().RegisterScope(name); }
+
+size_t ScopesCount() noexcept { return Registry::Instance().ScopesCount(); }
+
+std::string_view ScopeName(uint32_t scope) noexcept { return Registry::Instance().ScopeName(scope); }
+
+std::vector<TraceEvent> ThreadBuffer::Events() const {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto size = std::min<uint64_t>(head, kCapacity);
+
+    std::vector<TraceEvent> res;
+    res.reserve(size);
+    for (uint64_t i = head - size; i != head; ++i) {
+        res.push_back(events_[i % kCapacity]);
+    }
+    return res;
+}
+
+void ThreadBuffer::Clear() noexcept {
+    head_.store(0, std::memory_order_release);
+    for (auto &counter : counters_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    scopes_.fill({});
+}
+
+ThreadBuffer &CurrentThreadBuffer() {
+    thread_local ThreadBuffer &buffer = Registry::Instance().Register();
+    return buffer;
+}
+
+uint64_t NowNs() noexcept {
+    const auto elapsed = std::chrono::steady_clock::now() - kStartTime;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+uint64_t TotalCount(Counter counter) {
+    uint64_t total = 0;
+    Registry::Instance().ForEach([&](const ThreadBuffer &buffer) { total += buffer.CounterValue(counter); });
+    return total;
+}
+
+void WriteChromeTrace(std::ostream &out) {
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+    Registry::Instance().ForEach([&](const ThreadBuffer &buffer) {
+        for (const auto &event : buffer.Events()) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+
+            // ts и dur в Chrome trace-event задаются в микросекундах
+            out << "{\"name\":";
+            WriteJsonString(out, event.name);
+            out << std::format(",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", buffer.ThreadId(),
+                               event.start_ns / 1e3, event.duration_ns / 1e3);
+        }
+    });
+
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{";
+    for (size_t i = 0; i != kCountersNumber; ++i) {
+        const auto counter = static_cast<Counter>(i);
+        out << (i == 0 ? "" : ",");
+        WriteJsonString(out, CounterName(counter));
+        out << ':' << TotalCount(counter);
+    }
+    out << "}}\n";
+}
+
+void PrintSummary(std::ostream &out) {
+    const size_t scopes_count = ScopesCount();
+    std::map<std::string_view, ScopeStats> stats;
+    Registry::Instance().ForEach([&](const ThreadBuffer &buffer) {
+        for (uint32_t i = 0; i != scopes_count; ++i) {
+            const ScopeStats &scope = buffer.Scopes()[i];
+            if (scope.calls == 0) {
+                continue;
+            }
+            auto &s = stats[ScopeName(i)];
+            s.calls += scope.calls;
+            s.total_ns += scope.total_ns;
+            s.max_ns = std::max(s.max_ns, scope.max_ns);
+        }
+    });
+
+    out << std::format("{:<40} {:>10} {:>14} {:>14} {:>14}\n", "scope", "calls", "total, ms", "mean, us", "max, us");
+    for (const auto &[name, s] : stats) {
+        out << std::format("{:<40} {:>10} {:>14.3f} {:>14.3f} {:>14.3f}\n", name, s.calls, s.total_ns / 1e6,
+                           s.total_ns / 1e3 / s.calls, s.max_ns / 1e3);
+    }
+
+    out << std::format("\n{:<40} {:>10}\n", "counter", "value");
+    for (size_t i = 0; i != kCountersNumber; ++i) {
+        const auto counter = static_cast<Counter>(i);
+        out << std::format("{:<40} {:>10}\n", CounterName(counter), TotalCount(counter));
+    }
+}
+
+void Reset() {
+    Registry::Instance().ForEach([](ThreadBuffer &buffer) { buffer.Clear(); });
+}
+
+}  // namespace geometry::profiling
@@ -0,0 +1,320 @@
+#include "ray_casting.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace geometry::intersections {
+
+namespace {
+
+using Lanes = std::array<double, RayCaster::kLanes>;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+constexpr uint32_t kNoShape = ~uint32_t{0};
+
+// глубина дерева с разбиением по медиане не больше log2(n) + 1
+constexpr size_t kMaxDepth = 64;
+
+BoundingBox Merge(const BoundingBox &lhs, const BoundingBox &rhs) {
+    return {std::min(lhs.min_x, rhs.min_x), std::min(lhs.min_y, rhs.min_y), std::max(lhs.max_x, rhs.max_x),
+            std::max(lhs.max_y, rhs.max_y)};
+}
+
+/*
+ * Значения t, при которых o + d * t лежит в полосе [lo, hi]; inv = 1 / d. При d == 0 полоса содержит либо
+ * всю прямую, либо ничего: луч вдоль грани прямоугольника его задевает. Выбор без ветвлений
+ */
+std::pair<double, double> Slab(double lo, double hi, double o, double d, double inv) noexcept {
+    const double t1 = (lo - o) * inv;
+    const double t2 = (hi - o) * inv;
+    const bool inside = (lo <= o) & (o <= hi);
+    const bool flat = d == 0;
+    return {flat ? (inside ? -kInfinity : kInfinity) : std::min(t1, t2),
+            flat ? (inside ? kInfinity : -kInfinity) : std::max(t1, t2)};
+}
+
+}  // namespace
+
+// лучи пакета по дорожкам; у неактивных дорожек предел -1, и они ничего не задевают
+struct RayCaster::Packet {
+    Lanes ox{}, oy{};
+    Lanes dx{}, dy{};
+    // обратные направления для slab-проверки; у нулевой компоненты 0, она обрабатывается отдельно
+    Lanes ix{}, iy{};
+
+    explicit Packet(std::span<const Ray> rays) {
+        for (size_t lane = 0; lane != rays.size(); ++lane) {
+            const Ray &ray = rays[lane];
+            ox[lane] = ray.origin.x;
+            oy[lane] = ray.origin.y;
+            dx[lane] = ray.direction.x;
+            dy[lane] = ray.direction.y;
+            ix[lane] = dx[lane] != 0 ? 1 / dx[lane] : 0.0;
+            iy[lane] = dy[lane] != 0 ? 1 / dy[lane] : 0.0;
+        }
+    }
+
+    // есть ли дорожка, входящая в прямоугольник раньше своего предела
+    bool Hits(const BoundingBox &box, std::span<const double> limits) const noexcept {
+        bool res = false;
+        for (size_t lane = 0; lane != kLanes; ++lane) {
+            const auto [x_entry, x_exit] = Slab(box.min_x, box.max_x, ox[lane], dx[lane], ix[lane]);
+            const auto [y_entry, y_exit] = Slab(box.min_y, box.max_y, oy[lane], dy[lane], iy[lane]);
+            const double entry = std::max({x_entry, y_entry, 0.0});
+            const double exit = std::min(x_exit, y_exit);
+            res |= (entry <= exit) & (entry <= limits[lane]);
+        }
+        return res;
+    }
+};
+
+RayCaster::RayCaster(std::span<const Shape> shapes) : shapes_(shapes.size()) {
+    GEOMETRY_PROFILE_SCOPE("intersections::RayCaster");
+
+    auto add_edges = [this](ShapeRecord &record, std::span<const Point2D> points, bool closed) {
+        record.first_edge = static_cast<uint32_t>(x0_.size());
+        const size_t count = closed && points.size() > 2 ? points.size() : points.size() - 1;
+        for (size_t i = 0; i != count; ++i) {
+            const Point2D a = points[i];
+            const Point2D b = points[(i + 1) % points.size()];
+            x0_.push_back(a.x);
+            y0_.push_back(a.y);
+            ex_.push_back(b.x - a.x);
+            ey_.push_back(b.y - a.y);
+        }
+        record.edges_count = static_cast<uint32_t>(count);
+    };
+
+    std::vector<Point2D> centers(shapes.size());
+    for (uint32_t i = 0; i != shapes.size(); ++i) {
+        ShapeRecord &record = shapes_[i];
+        std::visit(
+            [&](const auto &shape) {
+                using T = std::decay_t<decltype(shape)>;
+                if constexpr (std::is_same_v<T, Circle>) {
+                    record.circle = true;
+                    record.center = shape.center_p;
+                    record.radius = std::abs(shape.radius);
+                } else if constexpr (std::is_same_v<T, Line>) {
+                    const std::array points{shape.start, shape.end};
+                    add_edges(record, points, false);
+                } else if constexpr (std::is_same_v<T, Polygon>) {
+                    if (!shape.Points().empty()) {
+                        add_edges(record, shape.Points(), true);
+                    }
+                } else {
+                    const auto points = shape.Vertices();
+                    if (!points.empty()) {
+                        add_edges(record, points, true);
+                    }
+                }
+                record.box = shape.BoundBox();
+            },
+            shapes[i]);
+        centers[i] = record.box.Center();
+        // фигуры без границы (пустой многоугольник) в дерево не попадают
+        if (record.circle || record.edges_count != 0) {
+            order_.push_back(i);
+        }
+    }
+
+    if (!order_.empty()) {
+        nodes_.reserve(2 * (order_.size() / kLeafSize + 1));
+        BuildNode(0, order_.size(), centers);
+    }
+}
+
+uint32_t RayCaster::BuildNode(size_t begin, size_t end, std::span<const Point2D> centers) {
+    const auto index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    BoundingBox box = shapes_[order_[begin]].box;
+    Point2D min_center = centers[order_[begin]];
+    Point2D max_center = min_center;
+    for (size_t i = begin + 1; i != end; ++i) {
+        const Point2D center = centers[order_[i]];
+        box = Merge(box, shapes_[order_[i]].box);
+        min_center = {std::min(min_center.x, center.x), std::min(min_center.y, center.y)};
+        max_center = {std::max(max_center.x, center.x), std::max(max_center.y, center.y)};
+    }
+    nodes_[index].box = box;
+    if (end - begin <= kLeafSize) {
+        nodes_[index].first = static_cast<uint32_t>(begin);
+        nodes_[index].count = static_cast<uint32_t>(end - begin);
+        return index;
+    }
+
+    const uint8_t axis = max_center.y - min_center.y > max_center.x - min_center.x ? 1 : 0;
+    const auto first = order_.begin() + begin;
+    const auto middle = order_.begin() + (begin + end) / 2;
+    const auto last = order_.begin() + end;
+    if (axis == 0) {
+        std::nth_element(first, middle, last,
+                         [&](uint32_t lhs, uint32_t rhs) { return centers[lhs].x < centers[rhs].x; });
+    } else {
+        std::nth_element(first, middle, last,
+                         [&](uint32_t lhs, uint32_t rhs) { return centers[lhs].y < centers[rhs].y; });
+    }
+
+    BuildNode(begin, (begin + end) / 2, centers);
+    const uint32_t right = BuildNode((begin + end) / 2, end, centers);
+    nodes_[index].first = right;
+    nodes_[index].axis = axis;
+    return index;
+}
+
+template <typename OnHit>
+void RayCaster::Traverse(const Packet &packet, std::span<const double> limits, OnHit &&on_hit) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    // порядок детей -- по направлению первого луча: пакет предполагается согласованным
+    const bool forward_x = packet.dx[0] >= 0;
+    const bool forward_y = packet.dy[0] >= 0;
+
+    Lanes res;
+    std::array<uint32_t, kMaxDepth> stack;
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top != 0) {
+        const Node &node = nodes_[stack[--top]];
+        if (!packet.Hits(node.box, limits)) {
+            continue;
+        }
+        if (node.count != 0) {
+            for (uint32_t i = node.first; i != node.first + node.count; ++i) {
+                IntersectShape(order_[i], packet, limits, res);
+                on_hit(order_[i], res);
+            }
+            continue;
+        }
+
+        const auto left = static_cast<uint32_t>(&node - nodes_.data() + 1);
+        const bool forward = node.axis == 0 ? forward_x : forward_y;
+        // ближний ребёнок кладётся последним и обходится первым
+        stack[top++] = forward ? node.first : left;
+        stack[top++] = forward ? left : node.first;
+    }
+}
+
+void RayCaster::IntersectShape(uint32_t shape, const Packet &packet, std::span<const double> limits,
+                               std::span<double> res) const noexcept {
+    const ShapeRecord &record = shapes_[shape];
+    std::ranges::fill(res, kInfinity);
+
+    if (record.circle) {
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+        // |f + d t|^2 = r^2, f = origin - center: ближний корень, если он не позади начала луча
+        for (size_t lane = 0; lane != kLanes; ++lane) {
+            const double fx = packet.ox[lane] - record.center.x;
+            const double fy = packet.oy[lane] - record.center.y;
+            const double a = packet.dx[lane] * packet.dx[lane] + packet.dy[lane] * packet.dy[lane];
+            const double b = fx * packet.dx[lane] + fy * packet.dy[lane];
+            const double c = fx * fx + fy * fy - record.radius * record.radius;
+            const double discriminant = b * b - a * c;
+            const double root = std::sqrt(std::max(discriminant, 0.0));
+            const double safe_a = a > 0 ? a : 1;
+            const double t0 = (-b - root) / safe_a;
+            const double t1 = (-b + root) / safe_a;
+            const double t = t0 >= 0 ? t0 : t1;
+            const bool hit = (discriminant >= 0) & (a > 0) & (t >= 0) & (t <= limits[lane]);
+            res[lane] = hit ? t : kInfinity;
+        }
+        return;
+    }
+
+    GEOMETRY_PROFILE_COUNT(PredicateEvaluations, record.edges_count);
+    // origin + d t = p + e s: t = (w x e) / (d x e), s = (w x d) / (d x e), w = p - origin
+    for (uint32_t i = record.first_edge; i != record.first_edge + record.edges_count; ++i) {
+        const double px = x0_[i];
+        const double py = y0_[i];
+        const double ex = ex_[i];
+        const double ey = ey_[i];
+        for (size_t lane = 0; lane != kLanes; ++lane) {
+            const double wx = px - packet.ox[lane];
+            const double wy = py - packet.oy[lane];
+            const double det = packet.dx[lane] * ey - packet.dy[lane] * ex;
+            const double safe_det = det != 0 ? det : 1;
+            const double t = (wx * ey - wy * ex) / safe_det;
+            const double s = (wx * packet.dy[lane] - wy * packet.dx[lane]) / safe_det;
+            const bool hit = (det != 0) & (s >= 0) & (s <= 1) & (t >= 0) & (t <= limits[lane]);
+            res[lane] = std::min(res[lane], hit ? t : kInfinity);
+        }
+    }
+}
+
+void RayCaster::Cast(std::span<const Ray> rays, std::span<std::optional<RayHit>> res) const {
+    const Packet packet{rays};
+    Lanes limits;
+    limits.fill(-1);
+    for (size_t lane = 0; lane != rays.size(); ++lane) {
+        limits[lane] = rays[lane].max_t;
+    }
+
+    std::array<uint32_t, kLanes> hits;
+    hits.fill(kNoShape);
+    // IntersectShape уже отбросила попадания дальше предела дорожки
+    Traverse(packet, limits, [&](uint32_t shape, const Lanes &t) {
+        for (size_t lane = 0; lane != kLanes; ++lane) {
+            const bool closer = t[lane] != kInfinity;
+            limits[lane] = closer ? t[lane] : limits[lane];
+            hits[lane] = closer ? shape : hits[lane];
+        }
+    });
+
+    for (size_t lane = 0; lane != rays.size(); ++lane) {
+        if (hits[lane] != kNoShape) {
+            res[lane] = RayHit{hits[lane], limits[lane], rays[lane].At(limits[lane])};
+        }
+    }
+}
+
+std::optional<RayHit> RayCaster::FirstHit(const Ray &ray) const {
+    std::optional<RayHit> res;
+    Cast({&ray, 1}, {&res, 1});
+    return res;
+}
+
+std::vector<RayHit> RayCaster::AllHits(const Ray &ray) const {
+    Lanes limits;
+    limits.fill(-1);
+    limits[0] = ray.max_t;
+
+    std::vector<RayHit> res;
+    Traverse(Packet{{&ray, 1}}, limits, [&](uint32_t shape, const Lanes &t) {
+        if (t[0] != kInfinity) {
+            res.push_back({shape, t[0], ray.At(t[0])});
+        }
+    });
+    std::ranges::sort(res, [](const RayHit &lhs, const RayHit &rhs) {
+        return std::tie(lhs.t, lhs.shape) < std::tie(rhs.t, rhs.shape);
+    });
+    return res;
+}
+
+std::vector<std::optional<RayHit>> RayCaster::FirstHits(std::span<const Ray> rays) const {
+    GEOMETRY_PROFILE_SCOPE("intersections::RayCaster::FirstHits");
+
+    std::vector<std::optional<RayHit>> res(rays.size());
+    const size_t packets = (rays.size() + kLanes - 1) / kLanes;
+    parallel::ForEachChunk(
+        packets,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                const size_t first = i * kLanes;
+                const size_t count = std::min(kLanes, rays.size() - first);
+                Cast(rays.subspan(first, count), std::span{res}.subspan(first, count));
+            }
+        },
+        64);
+    return res;
+}
+
+}  // namespace geometry::intersections
@@ -0,0 +1,181 @@
+#include "rotating_calipers.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace geometry::convex_hull {
+
+namespace {
+
+// положение опорных вершин для ребра (a, b) оболочки
+struct Caliper {
+    Point2D a, b;
+    // направление ребра b - a и внутренняя нормаль той же длины
+    Point2D u, n;
+    // крайние вершины вдоль u, вдоль n и вдоль -u
+    size_t right, top, left;
+};
+
+/*
+ * Обход рёбер с тремя опорными указателями. При повороте ребра крайние вершины сдвигаются только вперёд,
+ * поэтому за полный оборот каждый указатель проходит оболочку один раз
+ */
+template <typename F>
+void ForEachCaliper(std::span<const Point2D> hull, F &&f) {
+    const size_t h = hull.size();
+    auto next = [h](size_t k) { return k + 1 == h ? 0 : k + 1; };
+
+    bool started = false;
+    Caliper c{};
+    for (size_t i = 0; i != h; ++i) {
+        c.a = hull[i];
+        c.b = hull[next(i)];
+        c.u = c.b - c.a;
+        if (!(c.u.Dot(c.u) > 0)) {
+            continue;
+        }
+        c.n = {-c.u.y, c.u.x};
+
+        // сравниваются проекции без нормировки, она нужна только для итоговых размеров;
+        // проекция вдоль axis монотонна до максимума, шагов не больше h на случай вырождений
+        auto advance = [&](size_t &k, Point2D axis) {
+            for (size_t steps = 0; steps != h && (hull[next(k)] - c.a).Dot(axis) > (hull[k] - c.a).Dot(axis);
+                 ++steps) {
+                k = next(k);
+            }
+        };
+        // при первом ребре вершины идут по обходу: b, right, top, left
+        if (!started) {
+            c.right = next(i);
+        }
+        advance(c.right, c.u);
+        if (!started) {
+            c.top = c.right;
+        }
+        advance(c.top, c.n);
+        if (!started) {
+            c.left = c.top;
+            started = true;
+        }
+        advance(c.left, c.u * -1.0);
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+        f(c);
+    }
+}
+
+/*
+ * Обход против часовой стрелки (у обращённой оболочки внутренняя нормаль слева от ребра) без повторов
+ * соседних вершин: на повторе проекция не растёт, и опорный указатель остановился бы до максимума
+ */
+std::span<const Point2D> CounterClockwise(std::span<const Point2D> hull, std::vector<Point2D> &storage) {
+    double twice_area = 0;
+    bool repeated = false;
+    for (size_t i = 0, j = hull.size() - 1; i != hull.size(); j = i++) {
+        twice_area += (hull[j] - hull[0]).Cross(hull[i] - hull[0]);
+        repeated = repeated || (i != j && hull[i] == hull[j]);
+    }
+    if (twice_area >= 0 && !repeated) {
+        return hull;
+    }
+
+    storage.clear();
+    for (const Point2D p : hull) {
+        if (storage.empty() || storage.back() != p) {
+            storage.push_back(p);
+        }
+    }
+    while (storage.size() > 1 && storage.back() == storage.front()) {
+        storage.pop_back();
+    }
+    if (twice_area < 0) {
+        std::ranges::reverse(storage);
+    }
+    return storage;
+}
+
+// прямоугольник, прижатый к ребру, с наименьшим значением cost
+template <typename Cost>
+GeometryResult<OrientedBox> BestRectangle(std::span<const Point2D> hull, Cost &&cost) {
+    if (hull.empty()) {
+        return std::unexpected{GeometryError::InsufficientPoints};
+    }
+    std::vector<Point2D> storage;
+    hull = CounterClockwise(hull, storage);
+
+    // все вершины совпадают
+    OrientedBox res{hull[0], {1., 0.}, 0., 0.};
+    double best = std::numeric_limits<double>::infinity();
+    ForEachCaliper(hull, [&](const Caliper &c) {
+        const double length = c.u.Length();
+        const Point2D u = c.u / length;
+        const Point2D n = c.n / length;
+        // вершина a сама лежит на границе: ограничения снимают ошибки округления нормировки
+        const double min_u = std::min((hull[c.left] - c.a).Dot(u), 0.0);
+        const double max_u = std::max((hull[c.right] - c.a).Dot(u), 0.0);
+        const double max_n = std::max((hull[c.top] - c.a).Dot(n), 0.0);
+        const OrientedBox box{c.a + u * ((min_u + max_u) / 2) + n * (max_n / 2), u, (max_u - min_u) / 2, max_n / 2};
+        if (const double value = cost(box); value < best) {
+            best = value;
+            res = box;
+        }
+    });
+    return res;
+}
+
+}  // namespace
+
+GeometryResult<PointPair> FarthestPair(std::span<const Point2D> hull) {
+    GEOMETRY_PROFILE_SCOPE("convex_hull::FarthestPair");
+
+    if (hull.empty()) {
+        return std::unexpected{GeometryError::InsufficientPoints};
+    }
+    std::vector<Point2D> storage;
+    hull = CounterClockwise(hull, storage);
+
+    // диаметр достигается на антиподальной паре: концы ребра и самая далёкая от него вершина
+    PointPair res{hull[0], hull[0]};
+    double best = 0;
+    ForEachCaliper(hull, [&](const Caliper &c) {
+        for (const Point2D p : {c.a, c.b}) {
+            if (const double d = (hull[c.top] - p).Dot(hull[c.top] - p); d > best) {
+                best = d;
+                res = {p, hull[c.top]};
+            }
+        }
+    });
+    return res;
+}
+
+GeometryResult<double> Diameter(std::span<const Point2D> hull) {
+    const auto pair = FarthestPair(hull);
+    if (!pair) {
+        return std::unexpected{pair.error()};
+    }
+    return pair->Distance();
+}
+
+GeometryResult<double> Width(std::span<const Point2D> hull) {
+    GEOMETRY_PROFILE_SCOPE("convex_hull::Width");
+
+    const auto rectangle = BestRectangle(hull, [](const OrientedBox &box) { return box.half_width; });
+    if (!rectangle) {
+        return std::unexpected{rectangle.error()};
+    }
+    return 2 * rectangle->half_width;
+}
+
+GeometryResult<OrientedBox> MinAreaRectangle(std::span<const Point2D> hull) {
+    GEOMETRY_PROFILE_SCOPE("convex_hull::MinAreaRectangle");
+
+    return BestRectangle(hull, [](const OrientedBox &box) { return box.Area(); });
+}
+
+GeometryResult<OrientedBox> MinPerimeterRectangle(std::span<const Point2D> hull) {
+    GEOMETRY_PROFILE_SCOPE("convex_hull::MinPerimeterRectangle");
+
+    return BestRectangle(hull, [](const OrientedBox &box) { return box.Perimeter(); });
+}
+
+}  // namespace geometry::convex_hull
@@ -0,0 +1,279 @@
+#include "simplification.hpp"
+#include "parallel.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace geometry::simplification {
+
+namespace {
+
+constexpr double kAnchor = std::numeric_limits<double>::infinity();
+
+double SegmentDistance(Point2D p, Point2D a, Point2D b) {
+    const Point2D ab = b - a;
+    const double length2 = ab.Dot(ab);
+    const double t = length2 > 0 ? std::clamp((p - a).Dot(ab) / length2, 0.0, 1.0) : 0.0;
+    return p.DistanceTo(a + ab * t);
+}
+
+// хорда [first, last]; last == points.size() означает вершину 0 (замыкание кольца)
+struct Chord {
+    uint32_t first, last;
+    double limit;
+};
+
+/*
+ * Опорные вершины, которые сохраняются всегда, и начальные хорды между ними
+ *
+ * У ломаной это концы. У кольца -- вершина 0, самая далёкая от неё и самая далёкая от хорды между ними,
+ * поэтому невырожденное кольцо не схлопывается меньше чем в треугольник
+ */
+std::vector<Chord> Anchors(std::span<const Point2D> points, bool closed, std::vector<uint32_t> &anchors) {
+    const auto n = static_cast<uint32_t>(points.size());
+    if (!closed) {
+        anchors = {0, n - 1};
+        return {{0, n - 1, kAnchor}};
+    }
+
+    auto farthest = [&](auto distance) {
+        uint32_t res = 0;
+        double best = 0;
+        for (uint32_t i = 0; i != n; ++i) {
+            if (const double d = distance(points[i]); d > best) {
+                best = d;
+                res = i;
+            }
+        }
+        return res;
+    };
+
+    const uint32_t far = farthest([&](Point2D p) { return p.DistanceTo(points[0]); });
+    if (far == 0) {
+        anchors = {0};
+        return {};
+    }
+    const uint32_t apex = farthest([&](Point2D p) { return SegmentDistance(p, points[0], points[far]); });
+    if (apex == 0) {
+        anchors = {0, far};
+        return {{0, far, kAnchor}, {far, n, kAnchor}};
+    }
+
+    anchors = {0, std::min(far, apex), std::max(far, apex)};
+    return {{0, anchors[1], kAnchor}, {anchors[1], anchors[2], kAnchor}, {anchors[2], n, kAnchor}};
+}
+
+/*
+ * Дуглас-Пекер на явном стеке: visit(i, significance) вызывается для каждой вершины-разделителя дальше
+ * tolerance от своей хорды. significance -- расстояние до хорды, но не больше значимости родителя,
+ * поэтому уровни детализации вложены
+ */
+template <typename Visit>
+void Split(std::span<const Point2D> points, std::vector<Chord> stack, double tolerance, Visit &&visit) {
+    while (!stack.empty()) {
+        const auto [first, last, limit] = stack.back();
+        stack.pop_back();
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, last - first - 1);
+
+        const Point2D a = points[first];
+        const Point2D b = points[last % points.size()];
+        uint32_t split = first;
+        double best = -1;
+        for (uint32_t i = first + 1; i < last; ++i) {
+            if (const double d = SegmentDistance(points[i], a, b); d > best) {
+                best = d;
+                split = i;
+            }
+        }
+        if (split == first || best <= tolerance) {
+            continue;
+        }
+
+        const double significance = std::min(best, limit);
+        visit(split, significance);
+        stack.push_back({first, split, significance});
+        stack.push_back({split, last, significance});
+    }
+}
+
+}  // namespace
+
+std::vector<Point2D> DouglasPeucker(std::span<const Point2D> points, double tolerance, bool closed) {
+    GEOMETRY_PROFILE_SCOPE("simplification::DouglasPeucker");
+
+    if (points.size() <= (closed ? 3u : 2u)) {
+        return {points.begin(), points.end()};
+    }
+
+    std::vector<uint32_t> anchors;
+    auto chords = Anchors(points, closed, anchors);
+
+    std::vector<bool> keep(points.size(), false);
+    for (const uint32_t i : anchors) {
+        keep[i] = true;
+    }
+    Split(points, std::move(chords), tolerance, [&keep](uint32_t i, double) { keep[i] = true; });
+
+    std::vector<Point2D> res;
+    for (size_t i = 0; i != points.size(); ++i) {
+        if (keep[i]) {
+            res.push_back(points[i]);
+        }
+    }
+    return res;
+}
+
+std::vector<Point2D> Visvalingam(std::span<const Point2D> points, double min_area, bool closed) {
+    GEOMETRY_PROFILE_SCOPE("simplification::Visvalingam");
+
+    const auto n = static_cast<uint32_t>(points.size());
+    const uint32_t min_vertices = closed ? 3 : 2;
+    if (n <= min_vertices) {
+        return {points.begin(), points.end()};
+    }
+
+    // двусвязный список оставшихся вершин; концы ломаной не удаляются
+    std::vector<uint32_t> prev(n);
+    std::vector<uint32_t> next(n);
+    for (uint32_t i = 0; i != n; ++i) {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+    auto removable = [&](uint32_t i) { return closed || (i != 0 && i != n - 1); };
+    auto area = [&](uint32_t i) {
+        return std::abs((points[next[i]] - points[prev[i]]).Cross(points[i] - points[prev[i]])) / 2;
+    };
+
+    // куча с ленивой отменой: устаревшие записи отличаются версией
+    struct Entry {
+        double area;
+        uint32_t vertex, version;
+        bool operator>(const Entry &other) const noexcept { return area > other.area; }
+    };
+    std::vector<uint32_t> version(n, 0);
+    std::vector<Entry> entries;
+    entries.reserve(n);
+    for (uint32_t i = 0; i != n; ++i) {
+        if (removable(i)) {
+            entries.push_back({area(i), i, 0});
+        }
+    }
+    // начальная куча строится за O(n)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap{std::greater<>{}, std::move(entries)};
+
+    std::vector<bool> removed(n, false);
+    uint32_t alive = n;
+    while (!heap.empty() && alive > min_vertices) {
+        const Entry top = heap.top();
+        heap.pop();
+        if (top.version != version[top.vertex]) {
+            continue;
+        }
+        if (top.area >= min_area) {
+            break;
+        }
+
+        const uint32_t i = top.vertex;
+        removed[i] = true;
+        --alive;
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+
+        // площадь соседей не меньше удалённой: вершины уходят в порядке значимости
+        for (const uint32_t j : {prev[i], next[i]}) {
+            if (removable(j)) {
+                heap.push({std::max(area(j), top.area), j, ++version[j]});
+            }
+        }
+    }
+
+    std::vector<Point2D> res;
+    res.reserve(alive);
+    for (uint32_t i = 0; i != n; ++i) {
+        if (!removed[i]) {
+            res.push_back(points[i]);
+        }
+    }
+    return res;
+}
+
+Polygon Simplify(const Polygon &polygon, double tolerance) {
+    return Polygon{DouglasPeucker(polygon.Points(), tolerance, true)};
+}
+
+std::vector<Polygon> Simplify(std::span<const Polygon> polygons, double tolerance) {
+    GEOMETRY_PROFILE_SCOPE("simplification::Simplify");
+
+    std::vector<Polygon> res(polygons.size(), Polygon{{}});
+    parallel::ForEachChunk(
+        polygons.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i) {
+                res[i] = Simplify(polygons[i], tolerance);
+            }
+        },
+        64);
+    return res;
+}
+
+DetailHierarchy::DetailHierarchy(std::span<const Point2D> points, bool closed) : points_{points.begin(), points.end()} {
+    GEOMETRY_PROFILE_SCOPE("simplification::DetailHierarchy");
+
+    std::vector<double> significance(points.size(), kAnchor);
+    if (points.size() > (closed ? 3u : 2u)) {
+        std::vector<uint32_t> anchors;
+        auto chords = Anchors(points, closed, anchors);
+        std::vector<bool> is_anchor(points.size(), false);
+        for (const uint32_t i : anchors) {
+            is_anchor[i] = true;
+        }
+        // вершины, до которых не дошло разбиение (все точки совпадают), не нужны ни на одном уровне
+        for (size_t i = 0; i != points.size(); ++i) {
+            significance[i] = is_anchor[i] ? kAnchor : -1;
+        }
+        Split(points, std::move(chords), -1, [&significance](uint32_t i, double s) { significance[i] = s; });
+    }
+
+    order_.resize(points.size());
+    for (uint32_t i = 0; i != order_.size(); ++i) {
+        order_[i] = i;
+    }
+    std::ranges::stable_sort(order_, std::greater<>{}, [&significance](uint32_t i) { return significance[i]; });
+
+    significance_.reserve(order_.size());
+    for (const uint32_t i : order_) {
+        significance_.push_back(significance[i]);
+    }
+}
+
+// опорные вершины входят в любой уровень, даже при бесконечной точности
+size_t DetailHierarchy::VerticesCount(double tolerance) const {
+    return std::ranges::partition_point(significance_,
+                                        [tolerance](double s) { return s == kAnchor || s > tolerance; }) -
+           significance_.begin();
+}
+
+std::vector<Point2D> DetailHierarchy::Level(double tolerance) const {
+    std::vector<uint32_t> level(order_.begin(), order_.begin() + VerticesCount(tolerance));
+    std::ranges::sort(level);
+
+    std::vector<Point2D> res;
+    res.reserve(level.size());
+    for (const uint32_t i : level) {
+        res.push_back(points_[i]);
+    }
+    return res;
+}
+
+double DetailHierarchy::ToleranceFor(size_t max_vertices) const {
+    // меньше опорных вершин уровней не бывает: тогда подходит самый грубый уровень
+    const auto anchors = static_cast<size_t>(
+        std::ranges::partition_point(significance_, [](double s) { return s == kAnchor; }) - significance_.begin());
+    max_vertices = std::max(max_vertices, anchors);
+    return max_vertices < significance_.size() ? std::max(significance_[max_vertices], 0.0) : 0.0;
+}
+
+}  // namespace geometry::simplification
@@ -11,20 +11,82 @@ struct Multilambda : Ts... {
     using Ts::operator()...;
 };
 
-void Draw(std::span<const geometry::Shape> shapes) {
-    using namespace geometry;
+namespace {
+
+// цвета по номеру альтернативы Shape: Line, Triangle, Rectangle, RegularPolygon, Circle, Polygon
+constexpr std::array<const char *, kShapeKinds> kShapeColors = {"yellow", "blue", "green", "magenta", "red", "cyan"};
+
+matplot::figure_handle MakeFigure(const DrawOptions &options) {
     using namespace matplot;
 
     // Disable gnuplot warnings
     auto f = figure(false);
     f->backend()->run_command("unset warnings");
     f->ioff();
-    f->size(900, 900);
+    f->size(options.figure_size, options.figure_size);
 
     hold(on);     // Multiple plots mode
     axis(equal);  // Squre view
     grid(on);     // Enable grid by default
 
+    return f;
+}
+
+void DrawLabel(const Point2D &position, size_t index) {
+    auto t = matplot::text(position.x, position.y, std::to_string(index));
+    t->font_size(14);
+    t->color("black");
+}
+
+// одна команда plot на серию, независимо от числа фигур в ней
+void DrawBatches(const ShapeBatches &batches, std::span<const char *const, kShapeKinds> colors) {
+    using namespace matplot;
+
+    for (size_t kind = 0; kind != kShapeKinds; ++kind) {
+        const auto &outline = batches.outlines[kind];
+        if (!outline.x.empty()) {
+            plot(outline.x, outline.y)->line_width(2).color(colors[kind]);
+        }
+
+        const auto &points = batches.points[kind];
+        if (!points.x.empty()) {
+            plot(points.x, points.y, ".")->color(colors[kind]);
+        }
+    }
+
+    for (const auto &label : batches.labels) {
+        DrawLabel(label.position, label.index);
+    }
+}
+
+BatchOptions MakeBatchOptions(const DrawOptions &options, const BoundingBox &scene) {
+    BatchOptions res;
+    res.max_labels = options.max_labels;
+    if (options.level_of_detail) {
+        res.pixel_size = PixelSize(scene, options.figure_size);
+    }
+    return res;
+}
+
+}  // namespace
+
+void Draw(std::span<const geometry::Shape> shapes) { Draw(shapes, DrawOptions{}); }
+
+void Draw(std::span<const geometry::Shape> shapes, const DrawOptions &options) {
+    using namespace geometry;
+    using namespace matplot;
+
+    auto f = MakeFigure(options);
+
+    if (options.batched) {
+        const auto batches = BuildShapeBatches(shapes, MakeBatchOptions(options, SceneBoundBox(shapes)));
+        DrawBatches(batches, kShapeColors);
+
+        // Display plot
+        f->show();
+        return;
+    }
+
     for (const auto &[index, shape] : std::ranges::views::enumerate(shapes)) {
         std::visit(Multilambda{[&](const Line &line) {
                                    const auto lines = line.Lines();
@@ -54,28 +116,30 @@ void Draw(std::span<const geometry::Shape> shapes) {
 
         // Add shape number
         const auto center = shape.visit([](auto &&s) { return s.Center(); });
-        auto t = text(center.x, center.y, std::to_string(index));
-        t->font_size(14);
-        t->color("black");
+        DrawLabel(center, static_cast<size_t>(index));
     }
 
     // Display plot
     f->show();
 }
 
-void Draw(std::span<const geometry::triangulation::DelaunayTriangle> triangles) {
+void Draw(std::span<const geometry::triangulation::DelaunayTriangle> triangles) { Draw(triangles, DrawOptions{}); }
+
+void Draw(std::span<const geometry::triangulation::DelaunayTriangle> triangles, const DrawOptions &options) {
     using namespace geometry;
     using namespace matplot;
 
-    // Disable gnuplot warnings
-    auto f = figure(false);
-    f->backend()->run_command("unset warnings");
-    f->ioff();
-    f->size(900, 900);
+    auto f = MakeFigure(options);
 
-    hold(on);     // Multiple plots mode
-    axis(equal);  // Squre view
-    grid(on);     // Enable grid by default
+    if (options.batched) {
+        std::array<const char *, kShapeKinds> colors{};
+        colors.fill("cyan");
+        DrawBatches(BuildTriangleBatches(triangles, MakeBatchOptions(options, {})), colors);
+
+        // Display plot
+        f->show();
+        return;
+    }
 
     for (const auto &[index, d_triangle] : std::ranges::views::enumerate(triangles)) {
         geometry::Triangle tri{d_triangle.a, d_triangle.b, d_triangle.c};
@@ -83,10 +147,7 @@ void Draw(std::span<const geometry::triangulation::DelaunayTriangle> triangles)
         plot(lines.x, lines.y)->line_width(2).color("cyan");
 
         // Add triangle number
-        const auto center = tri.Center();
-        auto t = text(center.x, center.y, std::to_string(index));
-        t->font_size(14);
-        t->color("black");
+        DrawLabel(tri.Center(), static_cast<size_t>(index));
     }
 
     // Display plot
@@ -0,0 +1,441 @@
+#include "voronoi.hpp"
+#include "geometry.hpp"
+#include "profiling.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace geometry::voronoi {
+
+namespace {
+
+constexpr uint32_t kNoEvent = std::numeric_limits<uint32_t>::max();
+
+/*
+ * Дуга береговой линии: узел декартова дерева (по порядку слева направо) и двусвязного списка
+ */
+struct Arc {
+    Arc *parent = nullptr;
+    Arc *left = nullptr;
+    Arc *right = nullptr;
+    Arc *prev = nullptr;
+    Arc *next = nullptr;
+    Point2D point;  // копия сайта: поиск по дереву не обращается к массиву сайтов
+    uint32_t site = 0;
+    uint32_t priority = 0;
+    uint32_t event = kNoEvent;
+};
+
+// узлы выделяются блоками из resource, освобождённые переиспользуются через список свободных
+class ArcPool {
+public:
+    static constexpr size_t kBlockSize = 256;
+
+    explicit ArcPool(std::pmr::memory_resource *resource) : alloc_{resource}, blocks_{resource} {}
+    ~ArcPool() {
+        for (Arc *block : blocks_) {
+            alloc_.deallocate(block, kBlockSize);
+        }
+    }
+
+    ArcPool(const ArcPool &) = delete;
+    ArcPool &operator=(const ArcPool &) = delete;
+
+    Arc *Make(uint32_t site, Point2D point, uint32_t priority) {
+        Arc *arc = free_;
+        if (arc != nullptr) {
+            free_ = arc->next;
+        } else {
+            if (used_ == kBlockSize || blocks_.empty()) {
+                blocks_.push_back(alloc_.allocate(kBlockSize));
+                used_ = 0;
+            }
+            arc = blocks_.back() + used_++;
+        }
+        *arc = Arc{};
+        arc->point = point;
+        arc->site = site;
+        arc->priority = priority;
+        return arc;
+    }
+
+    void Free(Arc *arc) noexcept {
+        arc->next = free_;
+        free_ = arc;
+    }
+
+private:
+    std::pmr::polymorphic_allocator<Arc> alloc_;
+    std::pmr::vector<Arc *> blocks_;
+    size_t used_ = kBlockSize;
+    Arc *free_ = nullptr;
+};
+
+// абсцисса точки излома между дугами p (слева) и q (справа) при заметающей прямой y = l
+double Breakpoint(Point2D p, Point2D q, double l) {
+    if (p.y == q.y) {
+        return (p.x + q.x) / 2;
+    }
+    if (p.y == l) {
+        return p.x;
+    }
+    if (q.y == l) {
+        return q.x;
+    }
+
+    const double dp = 1 / (2 * (p.y - l));
+    const double dq = 1 / (2 * (q.y - l));
+    const double a = dp - dq;
+    const double b = 2 * (q.x * dq - p.x * dp);
+    const double c = (p.x * p.x + p.y * p.y - l * l) * dp - (q.x * q.x + q.y * q.y - l * l) * dq;
+    const double root = std::sqrt(std::max(b * b - 4 * a * c, 0.0));
+
+    // корень (-b - root) / 2a, записанный без вычитания близких величин
+    return b < 0 ? 2 * c / (root - b) : (-b - root) / (2 * a);
+}
+
+class BeachLine {
+public:
+    BeachLine(std::span<const Point2D> sites, std::pmr::memory_resource *resource) : sites_{sites}, pool_{resource} {}
+
+    bool Empty() const noexcept { return root_ == nullptr; }
+
+    // дуга над точкой p, заметающая прямая проходит через p
+    Arc *Locate(Point2D p) const noexcept {
+        Arc *arc = root_;
+        while (true) {
+            if (arc->prev != nullptr && arc->left != nullptr &&
+                p.x < Breakpoint(arc->prev->point, arc->point, p.y)) {
+                arc = arc->left;
+            } else if (arc->next != nullptr && arc->right != nullptr &&
+                       p.x > Breakpoint(arc->point, arc->next->point, p.y)) {
+                arc = arc->right;
+            } else {
+                return arc;
+            }
+        }
+    }
+
+    Arc *InsertFirst(uint32_t site) {
+        root_ = pool_.Make(site, sites_[site], NextPriority());
+        return root_;
+    }
+
+    Arc *InsertAfter(Arc *arc, uint32_t site) {
+        Arc *node = pool_.Make(site, sites_[site], NextPriority());
+        if (arc->right == nullptr) {
+            arc->right = node;
+            node->parent = arc;
+        } else {
+            // у следующей дуги в правом поддереве нет левого потомка
+            arc->next->left = node;
+            node->parent = arc->next;
+        }
+
+        node->prev = arc;
+        node->next = arc->next;
+        if (arc->next != nullptr) {
+            arc->next->prev = node;
+        }
+        arc->next = node;
+
+        while (node->parent != nullptr && node->priority > node->parent->priority) {
+            RotateUp(node);
+        }
+        return node;
+    }
+
+    void Remove(Arc *arc) {
+        while (arc->left != nullptr || arc->right != nullptr) {
+            Arc *child = arc->left == nullptr    ? arc->right
+                         : arc->right == nullptr ? arc->left
+                         : arc->left->priority > arc->right->priority ? arc->left
+                                                                      : arc->right;
+            RotateUp(child);
+        }
+        ReplaceChild(arc->parent, arc, nullptr);
+
+        if (arc->prev != nullptr) {
+            arc->prev->next = arc->next;
+        }
+        if (arc->next != nullptr) {
+            arc->next->prev = arc->prev;
+        }
+        pool_.Free(arc);
+    }
+
+private:
+    uint32_t NextPriority() noexcept {
+        // xorshift32: приоритеты декартова дерева
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 17;
+        seed_ ^= seed_ << 5;
+        return seed_;
+    }
+
+    void ReplaceChild(Arc *parent, Arc *old_child, Arc *new_child) noexcept {
+        if (parent == nullptr) {
+            root_ = new_child;
+        } else if (parent->left == old_child) {
+            parent->left = new_child;
+        } else {
+            parent->right = new_child;
+        }
+        if (new_child != nullptr) {
+            new_child->parent = parent;
+        }
+    }
+
+    void RotateUp(Arc *node) noexcept {
+        Arc *parent = node->parent;
+        ReplaceChild(parent->parent, parent, node);
+        if (parent->left == node) {
+            parent->left = node->right;
+            if (node->right != nullptr) {
+                node->right->parent = parent;
+            }
+            node->right = parent;
+        } else {
+            parent->right = node->left;
+            if (node->left != nullptr) {
+                node->left->parent = parent;
+            }
+            node->left = parent;
+        }
+        parent->parent = node;
+    }
+
+    std::span<const Point2D> sites_;
+    ArcPool pool_;
+    Arc *root_ = nullptr;
+    uint32_t seed_ = 2463534242u;
+};
+
+struct CircleEvent {
+    double y;
+    Arc *arc;
+    uint32_t id;
+
+    bool operator>(const CircleEvent &other) const noexcept { return y > other.y; }
+};
+
+/*
+ * Заметание снизу вверх. Каждое появление новой пары соседних дуг -- ребро диаграммы,
+ * пары сайтов собираются в neighbours
+ */
+class FortuneSweep {
+public:
+    FortuneSweep(std::span<const Point2D> sites, std::pmr::memory_resource *resource)
+        : sites_{sites}, beach_{sites, resource}, events_{resource}, neighbours_{resource} {}
+
+    void Run(std::span<const uint32_t> order) {
+        events_.reserve(order.size());
+        neighbours_.reserve(3 * order.size());
+
+        size_t next_site = 0;
+        while (next_site != order.size() || !events_.empty()) {
+            if (!events_.empty() &&
+                (next_site == order.size() || events_.front().y <= sites_[order[next_site]].y)) {
+                std::ranges::pop_heap(events_, std::greater{});
+                const CircleEvent event = events_.back();
+                events_.pop_back();
+                if (event.arc->event == event.id) {
+                    HandleCircle(event.arc);
+                }
+            } else {
+                HandleSite(order[next_site++]);
+            }
+        }
+    }
+
+    std::span<const std::pair<uint32_t, uint32_t>> Neighbours() const noexcept { return neighbours_; }
+
+private:
+    void HandleSite(uint32_t site) {
+        const Point2D p = sites_[site];
+        if (beach_.Empty()) {
+            beach_.InsertFirst(site);
+            return;
+        }
+
+        Arc *arc = beach_.Locate(p);
+        neighbours_.emplace_back(arc->site, site);
+
+        // первые сайты на одной горизонтали: дуги вырождены, новая встаёт справа без разбиения
+        if (arc->point.y == p.y) {
+            beach_.InsertAfter(arc, site);
+            return;
+        }
+
+        arc->event = kNoEvent;
+        Arc *middle = beach_.InsertAfter(arc, site);
+        Arc *right = beach_.InsertAfter(middle, arc->site);
+        CheckCircle(arc);
+        CheckCircle(right);
+    }
+
+    void HandleCircle(Arc *arc) {
+        GEOMETRY_PROFILE_COUNT(PredicateEvaluations, 1);
+
+        Arc *left = arc->prev;
+        Arc *right = arc->next;
+        neighbours_.emplace_back(left->site, right->site);
+
+        left->event = kNoEvent;
+        right->event = kNoEvent;
+        beach_.Remove(arc);
+        CheckCircle(left);
+        CheckCircle(right);
+    }
+
+    // дуга схлопнется, если её сайт и соседние идут против часовой стрелки
+    void CheckCircle(Arc *arc) {
+        const Arc *left = arc->prev;
+        const Arc *right = arc->next;
+        if (left == nullptr || right == nullptr || left->site == right->site) {
+            return;
+        }
+
+        const Point2D a = left->point;
+        const Point2D b = arc->point - a;
+        const Point2D c = right->point - a;
+        const double d = 2 * b.Cross(c);
+        if (d <= 0) {
+            return;
+        }
+
+        const double b2 = b.x * b.x + b.y * b.y;
+        const double c2 = c.x * c.x + c.y * c.y;
+        const Point2D center{(c.y * b2 - b.y * c2) / d, (b.x * c2 - c.x * b2) / d};
+        const double y = a.y + center.y + std::hypot(center.x, center.y);
+
+        arc->event = next_event_id_++;
+        events_.push_back({y, arc, arc->event});
+        std::ranges::push_heap(events_, std::greater{});
+    }
+
+    std::span<const Point2D> sites_;
+    BeachLine beach_;
+    std::pmr::vector<CircleEvent> events_;
+    std::pmr::vector<std::pair<uint32_t, uint32_t>> neighbours_;
+    uint32_t next_event_id_ = 0;
+};
+
+// отсечение выпуклого многоугольника полуплоскостью (p - origin) * normal <= 0
+void ClipByHalfPlane(const std::pmr::vector<Point2D> &in, std::pmr::vector<Point2D> &out, Point2D origin,
+                     Point2D normal) {
+    out.clear();
+    for (size_t i = 0; i != in.size(); ++i) {
+        const Point2D cur = in[i];
+        const Point2D next = in[(i + 1) % in.size()];
+        const double dc = (cur.x - origin.x) * normal.x + (cur.y - origin.y) * normal.y;
+        const double dn = (next.x - origin.x) * normal.x + (next.y - origin.y) * normal.y;
+
+        if (dc <= 0) {
+            out.push_back(cur);
+        }
+        if ((dc < 0 && dn > 0) || (dc > 0 && dn < 0)) {
+            const double t = dc / (dc - dn);
+            out.push_back({cur.x + t * (next.x - cur.x), cur.y + t * (next.y - cur.y)});
+        }
+    }
+}
+
+}  // namespace
+
+GeometryResult<VoronoiDiagram> FortuneVoronoi(std::span<const Point2D> sites, const BoundingBox &box) {
+    return FortuneVoronoi(sites, box, std::pmr::get_default_resource());
+}
+
+GeometryResult<VoronoiDiagram> FortuneVoronoi(std::span<const Point2D> sites, const BoundingBox &box,
+                                              std::pmr::memory_resource *resource) {
+    GEOMETRY_PROFILE_SCOPE("voronoi::FortuneVoronoi");
+
+    if (sites.empty()) {
+        return std::unexpected{GeometryError::InsufficientPoints};
+    }
+    if (!(box.min_x <= box.max_x && box.min_y <= box.max_y) || sites.size() >= kNoEvent) {
+        return std::unexpected{GeometryError::InvalidInput};
+    }
+
+    // порядок событий: по y, затем по x; повторы сайта ссылаются на вхождение с меньшим индексом
+    std::pmr::vector<uint32_t> order(sites.size(), resource);
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::sort(order, {}, [&sites](uint32_t i) { return std::tuple{sites[i].y, sites[i].x, i}; });
+
+    std::pmr::vector<uint32_t> representative(sites.size(), resource);
+    {
+        size_t unique = 0;
+        for (size_t i = 0; i != order.size(); ++i) {
+            const Point2D p = sites[order[i]];
+            if (unique != 0 && sites[order[unique - 1]].x == p.x && sites[order[unique - 1]].y == p.y) {
+                representative[order[i]] = order[unique - 1];
+            } else {
+                representative[order[i]] = order[i];
+                order[unique++] = order[i];
+            }
+        }
+        order.resize(unique);
+    }
+
+    FortuneSweep sweep{sites, resource};
+    sweep.Run(order);
+
+    // соседи каждого сайта подряд (CSR)
+    const auto neighbours = sweep.Neighbours();
+    std::pmr::vector<uint32_t> first(sites.size() + 1, 0u, resource);
+    for (const auto &[a, b] : neighbours) {
+        ++first[a + 1];
+        ++first[b + 1];
+    }
+    std::partial_sum(first.begin(), first.end(), first.begin());
+    std::pmr::vector<uint32_t> adjacent(first.back(), resource);
+    {
+        std::pmr::vector<uint32_t> fill(first.begin(), first.end() - 1, resource);
+        for (const auto &[a, b] : neighbours) {
+            adjacent[fill[a]++] = b;
+            adjacent[fill[b]++] = a;
+        }
+    }
+
+    VoronoiDiagram res;
+    res.offsets.reserve(sites.size() + 1);
+    res.vertices.reserve(6 * order.size());
+    res.offsets.push_back(0);
+
+    const std::array<Point2D, 4> corners{
+        {{box.min_x, box.min_y}, {box.max_x, box.min_y}, {box.max_x, box.max_y}, {box.min_x, box.max_y}}};
+    std::pmr::vector<Point2D> cell(resource);
+    std::pmr::vector<Point2D> clipped(resource);
+
+    for (uint32_t site = 0; site != sites.size(); ++site) {
+        const uint32_t owner = representative[site];
+        if (owner != site) {
+            for (size_t i = res.offsets[owner]; i != res.offsets[owner + 1]; ++i) {
+                res.vertices.push_back(res.vertices[i]);
+            }
+            res.offsets.push_back(static_cast<uint32_t>(res.vertices.size()));
+            continue;
+        }
+
+        const Point2D p = sites[owner];
+        cell.assign(corners.begin(), corners.end());
+        for (uint32_t i = first[owner]; i != first[owner + 1] && !cell.empty(); ++i) {
+            const Point2D q = sites[adjacent[i]];
+            ClipByHalfPlane(cell, clipped, {(p.x + q.x) / 2, (p.y + q.y) / 2}, q - p);
+            std::swap(cell, clipped);
+        }
+
+        res.vertices.insert(res.vertices.end(), cell.begin(), cell.end());
+        res.offsets.push_back(static_cast<uint32_t>(res.vertices.size()));
+    }
+
+    return res;
+}
+
+}  // namespace geometry::voronoi
@@ -0,0 +1,117 @@
+#include "bounding_volumes.hpp"
+#include "shape_utils.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::queries;
+
+namespace {
+
+// точки контура фигуры, окружность -- с шагом в градус
+std::vector<Point2D> Outline(const Shape &shape) {
+    return std::visit(
+        []<typename T>(const T &s) -> std::vector<Point2D> {
+            if constexpr (std::is_same_v<T, Circle>) {
+                return s.Vertices(360);
+            } else if constexpr (std::is_same_v<T, Polygon>) {
+                return {s.Points().begin(), s.Points().end()};
+            } else {
+                const auto vertices = s.Vertices();
+                return {vertices.begin(), vertices.end()};
+            }
+        },
+        shape);
+}
+
+bool Inside(const convex_hull::OrientedBox &box, Point2D p) {
+    return std::abs((p - box.center).Dot(box.axis)) <= box.half_length + 1e-9 &&
+           std::abs((p - box.center).Dot(box.Normal())) <= box.half_width + 1e-9;
+}
+
+}  // namespace
+
+TEST(bounding_volumes_test, min_enclosing_circle) {
+    EXPECT_EQ(GeometryError::InsufficientPoints, MinEnclosingCircle(std::span<const Point2D>{}).error());
+    EXPECT_EQ(Circle({1., 2.}, 0.), MinEnclosingCircle(std::vector<Point2D>{{1., 2.}, {1., 2.}}).value());
+
+    // перебор окружностей по парам и тройкам
+    std::mt19937 gen(20);
+    std::normal_distribution<double> dist(0., 100.);
+    for (int attempt = 0; attempt != 20; ++attempt) {
+        std::vector<Point2D> points(30);
+        for (auto &p : points) {
+            p = {dist(gen), 0.5 * dist(gen)};
+        }
+        const auto circle = MinEnclosingCircle(points).value();
+
+        auto encloses = [&](Point2D center, double radius) {
+            return std::ranges::all_of(points, [&](Point2D p) { return p.DistanceTo(center) <= radius + 1e-9; });
+        };
+        EXPECT_TRUE(encloses(circle.center_p, circle.radius));
+
+        double expected = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i != points.size(); ++i) {
+            for (size_t j = i + 1; j != points.size(); ++j) {
+                const Point2D center = (points[i] + points[j]) / 2.0;
+                if (const double r = points[i].DistanceTo(center); encloses(center, r)) {
+                    expected = std::min(expected, r);
+                }
+                for (size_t k = j + 1; k != points.size(); ++k) {
+                    const auto c = MinEnclosingCircle(std::vector<Point2D>{points[i], points[j], points[k]}).value();
+                    if (encloses(c.center_p, c.radius)) {
+                        expected = std::min(expected, c.radius);
+                    }
+                }
+            }
+        }
+        EXPECT_NEAR(expected, circle.radius, 1e-9 * expected);
+    }
+}
+
+TEST(bounding_volumes_test, shape_volumes) {
+    std::vector<Shape> shapes = utils::CounterBasedShapeGenerator{20}.GenerateShapes(500);
+    shapes.push_back(Polygon{{{0., 0.}, {1., 1.}, {3., 3.}}});
+    shapes.push_back(Polygon{{}});
+    shapes.push_back(Line{{1., 1.}, {1., 1.}});
+
+    for (const auto &shape : shapes) {
+        const auto volumes = GetBoundingVolumes(shape);
+        const auto box = volumes.box;
+        EXPECT_LE(volumes.oriented_box.Area(), box.Width() * box.Height() + 1e-9);
+        EXPECT_LE(volumes.circle.radius, std::hypot(box.Width(), box.Height()) / 2 + 1e-9);
+        for (const Point2D p : Outline(shape)) {
+            EXPECT_LE(p.DistanceTo(volumes.circle.center_p), volumes.circle.radius + 1e-9);
+            EXPECT_TRUE(Inside(volumes.oriented_box, p));
+        }
+    }
+
+    // охватывающая окружность всей сцены
+    const auto circle = MinEnclosingCircle(std::span<const Shape>{shapes}).value();
+    for (const auto &shape : shapes) {
+        for (const Point2D p : Outline(shape)) {
+            EXPECT_LE(p.DistanceTo(circle.center_p), circle.radius + 1e-9);
+        }
+    }
+}
+
+TEST(bounding_volumes_test, tightest_collisions) {
+    // параллельные диагональные отрезки: прямоугольники по осям пересекаются, сами отрезки -- нет
+    const std::vector<Shape> lines = {Line{{0., 0.}, {10., 10.}}, Line{{2., 0.}, {12., 10.}}};
+    EXPECT_EQ(1u, utils::FindAllCollisions(lines).size());
+    EXPECT_TRUE(utils::FindAllCollisions(lines, BoundingVolume::Tightest).empty());
+
+    // на случайной сцене пары Tightest -- подпоследовательность пар Box
+    const auto shapes = utils::CounterBasedShapeGenerator{20}.GenerateShapes(300);
+    const auto box = utils::FindAllCollisions(shapes);
+    const auto tightest = utils::FindAllCollisions(shapes, BoundingVolume::Tightest);
+    EXPECT_LT(tightest.size(), box.size());
+    auto it = box.begin();
+    for (const auto &pair : tightest) {
+        it = std::find(it, box.end(), pair);
+        ASSERT_NE(box.end(), it);
+    }
+}
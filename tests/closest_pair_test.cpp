@@ -0,0 +1,65 @@
+#include "closest_pair.hpp"
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::spatial;
+
+namespace {
+
+std::vector<Point2D> RandomPoints(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1000., 1000.);
+    std::vector<Point2D> points(count);
+    for (auto &p : points) {
+        // часть точек на общей вертикали и на целой решётке: равные x и совпадения
+        p = seed % 2 == 0 ? Point2D{dist(gen), dist(gen)} : Point2D{std::round(dist(gen) / 100), std::round(dist(gen))};
+    }
+    return points;
+}
+
+double SquaredDistance(Point2D a, Point2D b) { return (a - b).Dot(a - b); }
+
+}  // namespace
+
+TEST(closest_pair_test, closest_pair) {
+    EXPECT_EQ(GeometryError::InsufficientPoints, ClosestPair(std::vector<Point2D>{{1., 1.}}).error());
+
+    const std::vector<Point2D> points = {{0., 0.}, {10., 0.}, {5., 5.}, {10.5, 0.5}, {0., 10.}};
+    EXPECT_EQ(std::pair(1u, 3u), ClosestPair(points).value());
+
+    for (uint32_t seed : {1, 2, 3, 4}) {
+        // больше одного параллельного блока
+        const auto points = RandomPoints(seed < 3 ? 1000 : 200000, seed);
+        const auto [i, j] = ClosestPair(points).value();
+        ASSERT_LT(i, j);
+
+        const auto neighbours = AllNearestNeighbours(points);
+        double expected = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k != points.size(); ++k) {
+            expected = std::min(expected, SquaredDistance(points[k], points[neighbours[k]]));
+        }
+        EXPECT_EQ(expected, SquaredDistance(points[i], points[j]));
+    }
+}
+
+TEST(closest_pair_test, all_nearest_neighbours) {
+    EXPECT_EQ(std::vector<uint32_t>{kNoNeighbour}, AllNearestNeighbours(std::vector<Point2D>{{1., 1.}}));
+
+    for (uint32_t seed : {1, 2}) {
+        const auto points = RandomPoints(2000, seed);
+        const auto neighbours = AllNearestNeighbours(points);
+        for (size_t i = 0; i != points.size(); ++i) {
+            ASSERT_NE(i, neighbours[i]);
+            double expected = std::numeric_limits<double>::infinity();
+            for (size_t j = 0; j != points.size(); ++j) {
+                if (j != i) {
+                    expected = std::min(expected, SquaredDistance(points[i], points[j]));
+                }
+            }
+            ASSERT_EQ(expected, SquaredDistance(points[i], points[neighbours[i]]));
+        }
+    }
+}
@@ -1,6 +1,7 @@
 
 #include "convex_hull.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 
 using namespace geometry;
@@ -23,3 +24,72 @@ TEST(convex_hull_test, graham_scan_fail) {
     EXPECT_FALSE(expected.has_value());
     EXPECT_EQ(actual, expected.error());
 }
+
+TEST(convex_hull_test, graham_scan_float) {
+    std::vector<Point2Df> points = {{50.f, 100.f}, {55.f, 50.f}, {100.f, 0.f}, {50.f, 45.f}, {0.f, 0.f}, {45.f, 50.f}};
+
+    auto actual = std::vector<Point2Df>{{0.f, 0.f}, {100.f, 0.f}, {50.f, 100.f}};
+    auto expected = GrahamScan(points);
+    EXPECT_TRUE(expected.has_value());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(convex_hull_test, hull_of_shapes) {
+    {
+        // без окружностей совпадает с оболочкой всех вершин, внутренние фигуры не влияют
+        std::vector<Shape> shapes = {
+            Triangle{{0., 0.}, {100., 0.}, {50., 100.}},
+            Rectangle{{40., 10.}, 5., 5.},
+            Line{{-10., 20.}, {20., 30.}},
+            RegularPolygon{{50., 40.}, 3., 6},
+        };
+
+        auto actual = GrahamScan(std::vector<Point2D>{{0., 0.}, {100., 0.}, {50., 100.}, {-10., 20.}, {20., 30.}});
+        auto expected = ConvexHullOfShapes(shapes);
+        ASSERT_TRUE(expected.has_value());
+        EXPECT_EQ(actual, expected);
+    }
+
+    {
+        // точки оболочки окружности лежат на ней, стороны отходят от дуги не дальше допуска
+        const Circle circle{{5., 5.}, 50.};
+        const ChordTolerance tolerance{0.01};
+        std::vector<Shape> shapes = {circle, Circle{{0., 0.}, 1.}, Rectangle{{-10., -10.}, 20., 20.}};
+
+        auto hull = ConvexHullOfShapes(shapes, tolerance);
+        ASSERT_TRUE(hull.has_value());
+        EXPECT_LE(hull->size(), circle.Segments(tolerance) + 8);
+        for (size_t i = 0; i != hull->size(); ++i) {
+            const auto &p = (*hull)[i];
+            const auto mid = (p + (*hull)[(i + 1) % hull->size()]) / 2.;
+            EXPECT_TRUE(are_equals(circle.radius, p.DistanceTo(circle.center_p)));
+            EXPECT_LE(circle.radius - mid.DistanceTo(circle.center_p), tolerance.max_error);
+        }
+    }
+
+    {
+        // вершина оболочки ближе допуска к внутренней точке, которая раньше в лексикографическом порядке:
+        // предварительное удаление повторов не подменяет её этой точкой
+        const Point2D corner{5e-10, -5e-10};
+        const std::vector<Shape> shapes = {Triangle{corner, {100., 0.}, {50., 100.}}, Line{{0., 0.}, {50., 50.}}};
+
+        const auto hull = ConvexHullOfShapes(shapes);
+        ASSERT_TRUE(hull.has_value());
+        EXPECT_EQ(1, std::ranges::count_if(*hull, [&corner](const Point2D &p) {
+                      return p.x == corner.x && p.y == corner.y;
+                  }));
+    }
+
+    {
+        auto actual = GeometryError::InsufficientPoints;
+        auto expected = ConvexHullOfShapes(std::vector<Shape>{Line{{0., 0.}, {1., 1.}}});
+        EXPECT_FALSE(expected.has_value());
+        EXPECT_EQ(actual, expected.error());
+    }
+}
+
+TEST(convex_hull_test, support_point) {
+    EXPECT_EQ(Point2D(0., 10.), SupportPoint(Circle{{0., 0.}, 10.}, {0., 3.}));
+    EXPECT_EQ(Point2D(0., -10.), SupportPoint(RegularPolygon{{0., 0.}, 10., 4}, {0.1, -1.}));
+    EXPECT_EQ(Point2D(20., 40.), SupportPoint(Triangle{{10., 10.}, {20., 40.}, {30., 10.}}, {0., 1.}));
+}
@@ -0,0 +1,58 @@
+#include "delaunay_mesh.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::triangulation;
+
+TEST(delaunay_mesh_test, square) {
+    std::vector<Point2D> points = {{0., 0.}, {100., 0.}, {100., 100.}, {0., 100.}};
+
+    const auto mesh = DelaunayTriangulationMesh(points);
+    ASSERT_TRUE(mesh.has_value());
+    EXPECT_EQ(4u, mesh->Vertices().size());
+    ASSERT_EQ(2u, mesh->TrianglesCount());
+    EXPECT_EQ(4u, mesh->BoundaryEdges().size());
+
+    // диагональ -- единственное внутреннее ребро
+    const auto neighbours = mesh->Neighbours(0);
+    EXPECT_EQ(1u, std::ranges::count(neighbours, 1u));
+    EXPECT_EQ(2u, std::ranges::count(neighbours, kNoIndex));
+
+    EXPECT_EQ(DelaunayTriangulation(points), mesh->ToTriangles());
+}
+
+TEST(delaunay_mesh_test, connectivity) {
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{0., 1000.};
+    std::vector<Point2D> points(300);
+    for (auto &p : points) {
+        p = {dist(gen), dist(gen)};
+    }
+
+    const auto mesh = DelaunayTriangulationMesh(points);
+    ASSERT_TRUE(mesh.has_value());
+
+    for (uint32_t h = 0; h != mesh->HalfEdgesCount(); ++h) {
+        const uint32_t twin = mesh->Twin(h);
+        if (twin != kNoIndex) {
+            EXPECT_EQ(h, mesh->Twin(twin));
+            EXPECT_EQ(mesh->Origin(h), mesh->Target(twin));
+        }
+    }
+
+    // Эйлер для триангуляции выпуклой оболочки: T = 2V - 2 - B
+    const size_t boundary = mesh->BoundaryEdges().size();
+    EXPECT_EQ(2 * points.size() - 2 - boundary, mesh->TrianglesCount());
+
+    // каждый треугольник попадает в звёзды ровно трёх вершин
+    std::vector<int> seen(mesh->TrianglesCount());
+    for (uint32_t v = 0; v != points.size(); ++v) {
+        for (const uint32_t h : mesh->VertexStar(v)) {
+            EXPECT_EQ(v, mesh->Origin(h));
+            ++seen[DelaunayMesh::TriangleOf(h)];
+        }
+    }
+    EXPECT_TRUE(std::ranges::all_of(seen, [](int n) { return n == 3; }));
+}
@@ -127,3 +127,69 @@ TEST(geometry_test, triangle) {
         EXPECT_EQ(actual, expected);
     }
 }
+
+TEST(geometry_test, float_point) {
+    Point2Df a{1.f, 2.f};
+    Point2Df b{10.f, 20.f};
+
+    {
+        Point2Df actual = (a + b) * 3.f;
+        Point2Df expected = {33, 66};
+        EXPECT_EQ(actual, expected);
+    }
+
+    {
+        // допуск float крупнее, чем у double
+        EXPECT_TRUE(are_equals(1.f, 1.f + 5e-5f));
+        EXPECT_FALSE(are_equals(1., 1. + 5e-5));
+        EXPECT_FALSE(are_equals(1.f, 1.1f, 1e-3));
+
+        // целые и смешанные аргументы, как до шаблонов, сравниваются в double
+        EXPECT_TRUE(is_equal_zero(0));
+        EXPECT_TRUE(are_equals(2, 2));
+        EXPECT_FALSE(are_equals(1.f, 1. + 5e-5));
+    }
+
+    {
+        auto actual = static_cast<Point2Df>(Point2D{1.5, -2.5});
+        auto expected = Point2Df{1.5f, -2.5f};
+        EXPECT_EQ(actual, expected);
+    }
+
+    {
+        auto actual = BoundingBoxf{0.f, 0.f, 4.f, 2.f}.Center();
+        auto expected = Point2Df{2.f, 1.f};
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(geometry_test, circle_tessellation) {
+    {
+        EXPECT_EQ(3u, SegmentsForChordError(1.0, {2.0}));
+        EXPECT_EQ(8u, Circle({0., 0.}, 10.).Segments({0.8}));
+        EXPECT_GT(Circle({0., 0.}, 1000.).Segments({0.8}), Circle({0., 0.}, 10.).Segments({0.8}));
+    }
+
+    {
+        // середины хорд отстоят от окружности не дальше допуска
+        const Circle circle{{3., -4.}, 250.};
+        const ChordTolerance tolerance{0.01};
+        const auto pts = circle.Vertices(tolerance);
+        ASSERT_EQ(circle.Segments(tolerance), pts.size());
+
+        for (size_t i = 0; i != pts.size(); ++i) {
+            const auto mid = (pts[i] + pts[(i + 1) % pts.size()]) / 2.;
+            EXPECT_TRUE(are_equals(circle.radius, pts[i].DistanceTo(circle.center_p)));
+            EXPECT_LE(circle.radius - mid.DistanceTo(circle.center_p), tolerance.max_error);
+        }
+    }
+
+    {
+        // поворот на постоянный угол совпадает с вычислением каждой вершины через cos/sin
+        const RegularPolygon poly{{1., 2.}, 7., 1000};
+        const auto pts = poly.Vertices();
+        for (int i = 0; i != poly.sides; ++i) {
+            EXPECT_EQ(poly.Vertex(i), pts[i]);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#include "headless_export.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::visualization;
+
+namespace {
+
+size_t CountOccurrences(const std::string &text, std::string_view pattern) {
+    size_t count = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(headless_export_test, buffered_writer) {
+    // ёмкость меньше 64 байт увеличивается до 64
+    const std::string payload(100, 'z');
+    std::ostringstream out;
+    {
+        BufferedWriter writer{out, 8};
+        writer.Write("x=");
+        writer.Write(1.005, 1);
+        writer.Write(' ');
+        writer.Write(size_t{42});
+        writer.Write(' ');
+        EXPECT_TRUE(out.str().empty());
+
+        // запись длиннее буфера сбрасывает накопленное и уходит в поток сразу
+        writer.Write(payload);
+        EXPECT_EQ("x=1.0 42 " + payload, out.str());
+        writer.Write(" tail");
+    }
+    EXPECT_EQ("x=1.0 42 " + payload + " tail", out.str());
+}
+
+TEST(headless_export_test, svg) {
+    const std::vector<Shape> shapes = {
+        Circle{{0., 0.}, 5.},
+        Circle{{20., 0.}, 5.},
+        Rectangle{{31., 10.}, 10., 31.},
+        Circle{{10., 10.}, 0.001},
+    };
+
+    std::ostringstream out;
+    WriteSvg(out, shapes, {.max_labels = 10});
+    const auto svg = out.str();
+
+    EXPECT_TRUE(svg.starts_with("<svg "));
+    EXPECT_TRUE(svg.ends_with("</svg>\n"));
+    // контуры окружностей и прямоугольника, точка от мелкой окружности
+    EXPECT_EQ(3u, CountOccurrences(svg, "<path "));
+    EXPECT_EQ(1u, CountOccurrences(svg, "h0"));
+    EXPECT_EQ(4u, CountOccurrences(svg, "<text "));
+}
+
+TEST(headless_export_test, rasterize) {
+    const std::vector<Shape> shapes = {Rectangle{{0., 0.}, 100., 100.}};
+    const ExportOptions options{.width = 120, .height = 120, .margin = 10.0, .fill = true};
+    const auto image = Rasterize(shapes, options);
+
+    const Rgb white{255, 255, 255};
+    const Rgb green{0, 128, 0};
+    EXPECT_EQ(white, image.Pixel(2, 2));
+    EXPECT_EQ(green, image.Pixel(10, 60));
+    EXPECT_EQ(green, image.Pixel(60, 110));
+
+    // заливка смешана с белым фоном
+    const auto inside = image.Pixel(60, 60);
+    EXPECT_EQ((Rgb{128, 192, 128}), inside);
+
+    {
+        std::ostringstream out;
+        image.WritePpm(out);
+        EXPECT_EQ(std::string("P6\n120 120\n255\n").size() + 120 * 120 * 3, out.str().size());
+    }
+
+    {
+        std::ostringstream out;
+        image.WritePng(out);
+        const auto png = out.str();
+        EXPECT_TRUE(png.starts_with("\x89PNG\r\n\x1a\n"));
+        EXPECT_EQ("IEND", png.substr(png.size() - 8, 4));
+    }
+}
+
+TEST(headless_export_test, triangles) {
+    const std::vector<triangulation::DelaunayTriangle> triangles = {
+        {{0., 0.}, {100., 0.}, {0., 100.}},
+        {{100., 0.}, {100., 100.}, {0., 100.}},
+    };
+
+    std::ostringstream out;
+    WriteSvg(out, triangles);
+    EXPECT_EQ(1u, CountOccurrences(out.str(), "<path "));
+
+    const auto image = Rasterize(triangles, {.width = 120, .height = 120});
+    EXPECT_EQ((Rgb{0, 255, 255}), image.Pixel(60, 60));
+}
@@ -0,0 +1,142 @@
+#include "convex_hull.hpp"
+#include "incremental_delaunay.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::triangulation;
+
+namespace {
+
+// пустые описанные окружности и T = 2n - 2 - h для триангуляции выпуклой оболочки
+void ExpectDelaunay(const IncrementalDelaunay &dt) {
+    const auto triangles = dt.Triangles();
+    ASSERT_TRUE(triangles.has_value());
+
+    std::vector<Point2D> points;
+    for (const auto id : dt.Vertices()) {
+        points.push_back(dt.Point(id));
+    }
+    const auto hull = convex_hull::GrahamScan(points);
+    ASSERT_TRUE(hull.has_value());
+
+    // точки на рёбрах оболочки тоже граничные
+    const auto on_hull = std::ranges::count_if(points, [&hull](const Point2D &p) {
+        for (size_t i = 0; i != hull->size(); ++i) {
+            const Point2D a = (*hull)[i];
+            const Point2D b = (*hull)[(i + 1) % hull->size()];
+            if (std::abs((b - a).Cross(p - a)) < 1e-9 && (p - a).Dot(p - b) <= 0) {
+                return true;
+            }
+        }
+        return false;
+    });
+    EXPECT_EQ(2 * points.size() - 2 - on_hull, triangles->size());
+
+    for (const auto &t : *triangles) {
+        EXPECT_GT((t.b - t.a).Cross(t.c - t.a), 0.);
+        const Point2D center = t.Circumcenter();
+        const double radius = t.Circumradius();
+        for (const auto &p : points) {
+            EXPECT_GE(center.DistanceTo(p), radius - 1e-7);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(incremental_delaunay_test, insert_and_remove) {
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{0., 1000.};
+    std::vector<Point2D> points(400);
+    for (auto &p : points) {
+        p = {dist(gen), dist(gen)};
+    }
+
+    IncrementalDelaunay dt{points};
+    EXPECT_EQ(points.size(), dt.Size());
+    ExpectDelaunay(dt);
+
+    // повтор возвращает существующую точку
+    const auto id = dt.Vertices().front();
+    EXPECT_EQ(id, dt.Insert(dt.Point(id)));
+    EXPECT_EQ(points.size(), dt.Size());
+
+    // удаление половины, включая вершины оболочки
+    std::vector<IncrementalDelaunay::VertexId> ids(dt.Vertices().begin(), dt.Vertices().end());
+    std::ranges::shuffle(ids, gen);
+    ids.resize(ids.size() / 2);
+    for (const auto v : ids) {
+        EXPECT_TRUE(dt.Remove(v));
+    }
+    EXPECT_FALSE(dt.Remove(ids.front()));
+    EXPECT_EQ(points.size() - ids.size(), dt.Size());
+    ExpectDelaunay(dt);
+}
+
+TEST(incremental_delaunay_test, degenerate_sets) {
+    IncrementalDelaunay dt;
+    // пока точки на одной прямой, треугольников нет
+    const auto a = dt.Insert({0., 0.});
+    dt.Insert({1., 0.});
+    dt.Insert({2., 0.});
+    EXPECT_EQ(GeometryError::InsufficientPoints, dt.Triangles().error());
+
+    const auto apex = dt.Insert({1., 1.});
+    EXPECT_EQ(2u, dt.TrianglesCount());
+
+    // точка на ребре оболочки и решётка из совпадающих окружностей
+    dt.Insert({0.5, 0.});
+    for (int i = 0; i != 5; ++i) {
+        for (int j = 0; j != 5; ++j) {
+            dt.Insert({i * 0.5, 2. + j * 0.5});
+        }
+    }
+    ExpectDelaunay(dt);
+
+    std::vector<IncrementalDelaunay::VertexId> ids(dt.Vertices().begin(), dt.Vertices().end());
+    for (const auto v : ids) {
+        if (v != a && v != apex) {
+            dt.Remove(v);
+        }
+    }
+    EXPECT_EQ(2u, dt.Size());
+    EXPECT_EQ(0u, dt.TrianglesCount());
+}
+
+TEST(incremental_delaunay_test, remove_high_degree_vertex) {
+    // центр колеса соединён со всеми точками обода: дыра после удаления -- кольцо из 200 вершин
+    std::mt19937 gen{43};
+    std::uniform_real_distribution<double> noise{-0.5, 0.5};
+    std::vector<Point2D> points = {{0., 0.}};
+    for (int i = 0; i != 200; ++i) {
+        const double angle = 2 * std::numbers::pi * i / 200;
+        const double radius = 100. + noise(gen);
+        points.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    for (int i = 0; i != 50; ++i) {
+        points.emplace_back(300. + 10 * noise(gen), 10 * noise(gen));
+    }
+
+    IncrementalDelaunay dt{points};
+    const auto center = dt.Insert({0., 0.});
+    EXPECT_TRUE(dt.Remove(center));
+    ExpectDelaunay(dt);
+
+    // чередование вставок и удалений внутренних точек
+    std::uniform_real_distribution<double> inner{-60., 60.};
+    std::vector<IncrementalDelaunay::VertexId> inserted;
+    for (int i = 0; i != 300; ++i) {
+        if (inserted.empty() || i % 3 != 2) {
+            inserted.push_back(dt.Insert({inner(gen), inner(gen)}));
+        } else {
+            EXPECT_TRUE(dt.Remove(inserted[i % inserted.size()]));
+            inserted.erase(inserted.begin() + static_cast<ptrdiff_t>(i % inserted.size()));
+        }
+    }
+    ExpectDelaunay(dt);
+}
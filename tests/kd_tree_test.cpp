@@ -0,0 +1,92 @@
+#include "kd_tree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::spatial;
+
+namespace {
+
+std::vector<Point2D> RandomPoints(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-100., 100.);
+    std::vector<Point2D> points(count);
+    for (auto &p : points) {
+        // целая решётка: совпадающие точки и точки на границах запросов
+        p = {std::round(dist(gen)), std::round(dist(gen) / 4)};
+    }
+    return points;
+}
+
+double SquaredDistance(Point2D a, Point2D b) { return (a - b).Dot(a - b); }
+
+}  // namespace
+
+TEST(kd_tree_test, k_nearest) {
+    const auto points = RandomPoints(5000, 20);
+    const KdTree tree{points};
+    const auto queries = RandomPoints(200, 21);
+
+    constexpr size_t k = 10;
+    const auto batch = tree.KNearest(queries, k);
+    ASSERT_EQ(queries.size() * k, batch.size());
+    for (size_t q = 0; q != queries.size(); ++q) {
+        std::vector<double> expected;
+        for (const auto &p : points) {
+            expected.push_back(SquaredDistance(p, queries[q]));
+        }
+        std::ranges::sort(expected);
+        for (size_t i = 0; i != k; ++i) {
+            const auto &neighbour = batch[q * k + i];
+            ASSERT_EQ(expected[i], neighbour.distance2);
+            ASSERT_EQ(expected[i], SquaredDistance(points[neighbour.index], queries[q]));
+        }
+    }
+
+    // точек меньше, чем k
+    std::vector<KdTree::Neighbour> out(5);
+    const KdTree small{std::vector<Point2D>{{0., 0.}, {3., 4.}}};
+    EXPECT_EQ(2u, small.KNearest({0., 1.}, out));
+    EXPECT_EQ(0u, out[0].index);
+    EXPECT_EQ(18., out[1].distance2);
+    EXPECT_EQ(KdTree::kNoPoint, out[2].index);
+    EXPECT_EQ(0u, KdTree{{}}.KNearest({0., 0.}, out));
+}
+
+TEST(kd_tree_test, radius_and_range) {
+    const auto points = RandomPoints(5000, 22);
+    const KdTree tree{points};
+
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<double> dist(-120., 120.);
+    std::vector<BoundingBox> boxes;
+    for (int q = 0; q != 200; ++q) {
+        const Point2D p{std::round(dist(gen)), std::round(dist(gen) / 4)};
+        const double radius = std::round(std::abs(dist(gen)) / 10);
+
+        std::vector<uint32_t> actual;
+        tree.ForEachInRadius(p, radius, [&actual](uint32_t i) { actual.push_back(i); });
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i != points.size(); ++i) {
+            if (SquaredDistance(points[i], p) <= radius * radius) {
+                expected.push_back(i);
+            }
+        }
+        std::ranges::sort(actual);
+        ASSERT_EQ(expected, actual);
+
+        boxes.push_back({p.x - radius, p.y - radius / 2, p.x + 2 * radius, p.y + radius});
+    }
+    boxes.push_back({-1000., -1000., 1000., 1000.});
+
+    const auto counts = tree.RangeCount(boxes);
+    for (size_t q = 0; q != boxes.size(); ++q) {
+        const auto &box = boxes[q];
+        const auto expected = std::ranges::count_if(points, [&box](Point2D p) {
+            return box.min_x <= p.x && p.x <= box.max_x && box.min_y <= p.y && p.y <= box.max_y;
+        });
+        ASSERT_EQ(static_cast<size_t>(expected), counts[q]);
+    }
+}
@@ -0,0 +1,94 @@
+#include "memory_tracking.hpp"
+#include "queries.hpp"
+#include "triangulation.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::memory;
+
+/*
+ * Бюджеты аллокаций на горячих путях: при регрессии тесты падают
+ */
+class memory_tracking_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!GlobalHooksInstalled()) {
+            GTEST_SKIP() << "global operator new/delete hooks are not linked";
+        }
+    }
+
+    const std::vector<Shape> shapes = {
+        Line{{0., 0.}, {10., 10.}},
+        Triangle{{10., 10.}, {20., 40.}, {30., 10.}},
+        Rectangle{{31., 10.}, 10., 31.},
+        RegularPolygon{{-20., -20.}, 10., 7},
+        Circle{{9., 10.}, 5.},
+        Polygon{{{0., 0.}, {50., 0.}, {50., 50.}, {25., 75.}, {0., 50.}}},
+    };
+};
+
+TEST_F(memory_tracking_test, counts_global_allocations) {
+    ScopedAllocationCounter counter;
+    std::vector<int> v(100);
+    v.push_back(1);
+
+    EXPECT_EQ(2u, counter.Allocations());
+    EXPECT_GE(counter.Bytes(), 100 * sizeof(int));
+}
+
+TEST_F(memory_tracking_test, distance_to_point_budget) {
+    const std::vector<Point2D> points = {{10., 10.}, {-100., 35.}, {25., 30.}};
+
+    ScopedAllocationCounter counter;
+    double sum = 0.0;
+    for (const auto &shape : shapes) {
+        for (const auto &point : points) {
+            sum += queries::DistanceToPoint(shape, point);
+        }
+    }
+
+    EXPECT_GT(sum, 0.0);
+    EXPECT_EQ(0u, counter.Allocations());
+}
+
+TEST_F(memory_tracking_test, bound_box_budget) {
+    ScopedAllocationCounter counter;
+    double sum = 0.0;
+    for (const auto &shape : shapes) {
+        sum += queries::GetHeight(shape);
+        sum += queries::BoundingBoxesOverlap(shape, shapes.front());
+    }
+
+    EXPECT_GT(sum, 0.0);
+    EXPECT_EQ(0u, counter.Allocations());
+}
+
+TEST_F(memory_tracking_test, delaunay_budget) {
+    std::vector<Point2D> points;
+    for (int i = 0; i != 20; ++i) {
+        for (int j = 0; j != 20; ++j) {
+            points.emplace_back(i * 10. + (j % 3), j * 10. + (i % 5));
+        }
+    }
+
+    ScopedAllocationCounter counter;
+    auto triangles = triangulation::DelaunayTriangulation(points);
+    ASSERT_TRUE(triangles.has_value());
+
+    // память под буферы растёт геометрически, а не выделяется на каждую вставку
+    EXPECT_LT(counter.Allocations(), 100u);
+}
+
+TEST(counting_resource_test, counts_upstream_requests) {
+    CountingResource resource;
+    {
+        std::pmr::vector<int> v(&resource);
+        v.resize(10);
+        v.resize(1000);
+    }
+
+    auto actual = AllocationStats{2, 2, 10 * sizeof(int) + 1000 * sizeof(int)};
+    auto expected = resource.Stats();
+    EXPECT_EQ(actual, expected);
+}
@@ -0,0 +1,113 @@
+#include "narrow_phase.hpp"
+#include "queries.hpp"
+#include "shape_utils.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <format>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::intersections;
+
+namespace {
+
+// принадлежность точки замкнутой фигуре (Line -- отрезку) перебором рёбер
+bool InsideShape(const Shape &shape, Point2D p) {
+    if (const auto *circle = std::get_if<Circle>(&shape)) {
+        return p.DistanceTo(circle->center_p) <= std::abs(circle->radius);
+    }
+    if (const auto *line = std::get_if<Line>(&shape)) {
+        return std::abs((line->end - line->start).Cross(p - line->start)) <= 1e-9 * line->Length() &&
+               (p - line->start).Dot(p - line->end) <= 0;
+    }
+
+    const auto vertices = std::visit(
+        [](const auto &s) {
+            const auto points = s.Vertices();
+            return std::vector<Point2D>(points.begin(), points.end());
+        },
+        shape);
+    bool inside = false;
+    for (size_t i = 0, j = vertices.size() - 1; i != vertices.size(); j = i++) {
+        const Point2D a = vertices[i];
+        const Point2D b = vertices[j];
+        if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+}  // namespace
+
+TEST(narrow_phase_test, shape_pairs) {
+    const Shape circle = Circle{{0., 0.}, 5.};
+
+    // прямоугольники по осям пересекаются во всех парах ниже
+    EXPECT_TRUE(ShapesOverlap(circle, Circle{{8., 0.}, 3.}));
+    EXPECT_FALSE(ShapesOverlap(circle, Circle{{6., 6.}, 3.}));
+    EXPECT_FALSE(ShapesOverlap(circle, Rectangle{{4., 4.}, 3., 3.}));
+    EXPECT_TRUE(ShapesOverlap(circle, Rectangle{{3., 3.}, 3., 3.}));
+    EXPECT_TRUE(ShapesOverlap(circle, Triangle{{-1., -1.}, {1., -1.}, {0., 1.}}));
+    EXPECT_TRUE(ShapesOverlap(Triangle{{-1., -1.}, {1., -1.}, {0., 1.}}, Rectangle{{-10., -10.}, 20., 20.}));
+    EXPECT_FALSE(ShapesOverlap(Triangle{{0., 0.}, {10., 0.}, {0., 10.}}, Rectangle{{6., 6.}, 4., 4.}));
+    EXPECT_FALSE(ShapesOverlap(Line{{0., 0.}, {10., 10.}}, Line{{2., 0.}, {12., 10.}}));
+    EXPECT_TRUE(ShapesOverlap(Line{{0., 0.}, {10., 10.}}, Line{{0., 10.}, {10., 0.}}));
+    EXPECT_FALSE(ShapesOverlap(Line{{0., 0.}, {1., 1.}}, Line{{2., 2.}, {3., 3.}}));
+    EXPECT_TRUE(ShapesOverlap(Line{{0., 0.}, {2., 2.}}, Line{{1., 1.}, {3., 3.}}));
+    EXPECT_FALSE(ShapesOverlap(Line{{0., 8.}, {8., 0.}}, circle));
+    EXPECT_TRUE(ShapesOverlap(Rectangle{{0., 0.}, 4., 0.}, Line{{2., -1.}, {2., 1.}}));
+
+    // невыпуклый многоугольник-уголок: окружность в вырезе его не задевает, прямоугольник внутри -- задевает
+    const Shape corner = Polygon{{{0., 0.}, {10., 0.}, {10., 2.}, {2., 2.}, {2., 10.}, {0., 10.}}};
+    EXPECT_FALSE(ShapesOverlap(corner, Circle{{6., 6.}, 3.}));
+    EXPECT_TRUE(ShapesOverlap(Circle{{6., 6.}, 6.}, corner));
+    EXPECT_TRUE(ShapesOverlap(corner, Rectangle{{0.5, 0.5}, 1., 1.}));
+    EXPECT_FALSE(ShapesOverlap(corner, Triangle{{4., 4.}, {9., 4.}, {4., 9.}}));
+    EXPECT_TRUE(ShapesOverlap(corner, Polygon{{{-1., -1.}, {11., -1.}, {11., 11.}, {-1., 11.}}}));
+    EXPECT_FALSE(ShapesOverlap(corner, Polygon{{}}));
+}
+
+TEST(narrow_phase_test, filter_candidates) {
+    const auto shapes = utils::CounterBasedShapeGenerator{20}.GenerateShapes(300);
+    std::vector<ShapePair> candidates;
+    for (uint32_t i = 0; i != shapes.size(); ++i) {
+        for (uint32_t j = i + 1; j != shapes.size(); ++j) {
+            if (queries::BoundingBoxesOverlap(shapes[i], shapes[j])) {
+                candidates.emplace_back(i, j);
+            }
+        }
+    }
+
+    const NarrowPhase narrow_phase{shapes};
+    const auto overlapping = narrow_phase.Filter(candidates);
+    EXPECT_LT(overlapping.size(), candidates.size());
+    auto it = candidates.begin();
+    for (const auto [first, second] : overlapping) {
+        it = std::find(it, candidates.end(), ShapePair{first, second});
+        ASSERT_NE(candidates.end(), it);
+    }
+
+    for (const auto [first, second] : candidates) {
+        const bool overlaps = std::ranges::binary_search(overlapping, ShapePair{first, second});
+        EXPECT_EQ(overlaps, narrow_phase.Overlaps(second, first));
+        EXPECT_EQ(overlaps, ShapesOverlap(shapes[first], shapes[second]));
+
+        // общая точка на сетке пересечения прямоугольников -- пересечение есть
+        const auto lhs = queries::GetBoundBox(shapes[first]);
+        const auto rhs = queries::GetBoundBox(shapes[second]);
+        const BoundingBox common{std::max(lhs.min_x, rhs.min_x), std::max(lhs.min_y, rhs.min_y),
+                                 std::min(lhs.max_x, rhs.max_x), std::min(lhs.max_y, rhs.max_y)};
+        bool sampled = false;
+        for (int x = 0; x <= 16 && !sampled; ++x) {
+            for (int y = 0; y <= 16 && !sampled; ++y) {
+                const Point2D p{common.min_x + common.Width() * x / 16, common.min_y + common.Height() * y / 16};
+                sampled = InsideShape(shapes[first], p) && InsideShape(shapes[second], p);
+            }
+        }
+        EXPECT_TRUE(overlaps || !sampled) << std::format("{} {}", shapes[first], shapes[second]);
+    }
+
+    const auto overlaps = utils::FindAllOverlaps(shapes);
+    EXPECT_EQ(overlapping.size(), overlaps.size());
+}
@@ -0,0 +1,96 @@
+#include "plot_batch.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::visualization;
+
+namespace {
+
+size_t CountBreaks(const Lines2DDyn &lines) {
+    return static_cast<size_t>(std::ranges::count_if(lines.x, [](double x) { return std::isnan(x); }));
+}
+
+}  // namespace
+
+TEST(plot_batch_test, one_series_per_type) {
+    const std::vector<Shape> shapes = {
+        Circle{{0., 0.}, 5.},
+        Triangle{{10., 10.}, {20., 40.}, {30., 10.}},
+        Circle{{20., 0.}, 5.},
+        Line{{0., 0.}, {10., 10.}},
+    };
+
+    const auto batches = BuildShapeBatches(shapes, {});
+    const auto &circles = batches.outlines[shapes[0].index()];
+
+    // 100 сегментов + замыкание + NaN на каждую окружность
+    EXPECT_EQ(2u, CountBreaks(circles));
+    EXPECT_EQ(2u * 102u, circles.x.size());
+    EXPECT_EQ(1u, CountBreaks(batches.outlines[shapes[1].index()]));
+    EXPECT_EQ(3u, batches.outlines[shapes[3].index()].x.size());
+    EXPECT_EQ(4u, batches.labels.size());
+}
+
+TEST(plot_batch_test, level_of_detail) {
+    BatchOptions options;
+    options.pixel_size = 1.0;
+
+    {
+        // r * (1 - cos(pi / n)) <= 0.25 пикселя при r = 20 пикселей
+        EXPECT_EQ(20u, CircleSegments(20.0, options));
+        EXPECT_EQ(options.min_circle_segments, CircleSegments(0.5, options));
+        EXPECT_EQ(options.max_circle_segments, CircleSegments(1000.0, options));
+    }
+
+    {
+        // вырожденные пределы не дают окружности меньше треугольника
+        BatchOptions degenerate = options;
+        degenerate.max_circle_segments = 0;
+        EXPECT_EQ(3u, CircleSegments(20.0, degenerate));
+        degenerate.pixel_size = 0.0;
+        EXPECT_EQ(3u, CircleSegments(20.0, degenerate));
+        degenerate.max_circle_segments = 100;
+        degenerate.min_circle_segments = 1;
+        degenerate.pixel_size = 1.0;
+        EXPECT_EQ(3u, CircleSegments(0.5, degenerate));
+
+        const std::vector<Shape> circle = {Circle{{0., 0.}, 20.}};
+        degenerate.max_circle_segments = 0;
+        const auto batches = BuildShapeBatches(circle, degenerate);
+        EXPECT_EQ(5u, batches.outlines[circle[0].index()].x.size());
+    }
+
+    {
+        const std::vector<Shape> shapes = {
+            Circle{{0., 0.}, 0.2},
+            Rectangle{{5., 5.}, 0.5, 0.5},
+            Rectangle{{10., 10.}, 20., 20.},
+        };
+
+        const auto batches = BuildShapeBatches(shapes, options);
+        EXPECT_EQ(1u, batches.points[shapes[0].index()].x.size());
+        EXPECT_EQ(1u, batches.points[shapes[1].index()].x.size());
+        EXPECT_EQ(1u, CountBreaks(batches.outlines[shapes[2].index()]));
+    }
+}
+
+TEST(plot_batch_test, label_decimation) {
+    std::vector<Shape> shapes;
+    for (int i = 0; i != 1000; ++i) {
+        shapes.push_back(Circle{{static_cast<double>(i), 0.}, 1.});
+    }
+
+    BatchOptions options;
+    options.max_labels = 100;
+    {
+        const auto batches = BuildShapeBatches(shapes, options);
+        ASSERT_EQ(100u, batches.labels.size());
+        EXPECT_EQ(10u, batches.labels[1].index);
+        EXPECT_EQ(Point2D(10., 0.), batches.labels[1].position);
+    }
+
+    options.max_labels = 0;
+    EXPECT_TRUE(BuildShapeBatches(shapes, options).labels.empty());
+}
@@ -0,0 +1,79 @@
+#include "point_classifier.hpp"
+#include "voronoi.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::queries;
+
+namespace {
+
+// перебор всех регионов с тем же предикатом пересечения луча
+uint32_t BruteForce(std::span<const Polygon> regions, Point2D p) {
+    for (uint32_t r = 0; r != regions.size(); ++r) {
+        const auto pts = regions[r].Points();
+        bool inside = false;
+        for (size_t i = 0, j = pts.size() - 1; i < pts.size(); j = i++) {
+            if (((pts[i].y > p.y) != (pts[j].y > p.y)) &&
+                (p.x < (pts[j].x - pts[i].x) * (p.y - pts[i].y) / (pts[j].y - pts[i].y) + pts[i].x)) {
+                inside = !inside;
+            }
+        }
+        if (pts.size() >= 3 && inside) {
+            return r;
+        }
+    }
+    return RegionClassifier::kNoRegion;
+}
+
+}  // namespace
+
+TEST(point_classifier_test, overlapping_regions) {
+    const std::vector<Polygon> regions = {
+        Polygon{{{0., 0.}, {10., 0.}, {10., 10.}, {0., 10.}}},
+        // невыпуклый регион, частично перекрывающий первый
+        Polygon{{{5., 5.}, {20., 5.}, {20., 20.}, {12., 20.}, {12., 8.}, {5., 8.}}},
+        Polygon{{{30., 30.}, {31., 30.}}},
+    };
+    const RegionClassifier classifier{regions};
+
+    EXPECT_EQ(0u, classifier.Classify({1., 1.}));
+    EXPECT_EQ(0u, classifier.Classify({6., 6.}));
+    EXPECT_EQ(1u, classifier.Classify({15., 6.}));
+    EXPECT_EQ(1u, classifier.Classify({15., 15.}));
+    EXPECT_EQ(RegionClassifier::kNoRegion, classifier.Classify({8., 15.}));
+    EXPECT_EQ(RegionClassifier::kNoRegion, classifier.Classify({-1., 1.}));
+    EXPECT_EQ(RegionClassifier::kNoRegion, classifier.Classify({30.5, 30.}));
+}
+
+TEST(point_classifier_test, matches_brute_force) {
+    // регионы -- ячейки Вороного, точки и на случайных местах, и на узлах решётки (совпадения с вершинами)
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> dist(0., 1000.);
+    std::vector<Point2D> sites(300);
+    for (auto &p : sites) {
+        p = {dist(gen), dist(gen)};
+    }
+    const auto diagram = voronoi::FortuneVoronoi(sites, {0., 0., 1000., 1000.}).value();
+    std::vector<Polygon> regions;
+    for (size_t i = 0; i != diagram.CellsCount(); ++i) {
+        regions.push_back(diagram.CellPolygon(i));
+    }
+    regions.push_back(Polygon{{{100., 100.}, {900., 100.}, {500., 900.}}});
+
+    std::vector<Point2D> points(20000);
+    for (size_t i = 0; i != points.size(); ++i) {
+        points[i] = i % 2 == 0 ? Point2D{dist(gen), dist(gen)} : Point2D{std::round(dist(gen)), 0.};
+    }
+    for (const auto &region : regions) {
+        points.push_back(region.Points().front());
+    }
+
+    const RegionClassifier classifier{regions};
+    const auto actual = classifier.Classify(points);
+    ASSERT_EQ(points.size(), actual.size());
+    for (size_t i = 0; i != points.size(); ++i) {
+        ASSERT_EQ(BruteForce(regions, points[i]), actual[i]) << i;
+    }
+}
@@ -0,0 +1,68 @@
+#include "point_location.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::triangulation;
+
+namespace {
+
+bool Contains(const DelaunayMesh &mesh, uint32_t t, Point2D p) {
+    for (uint32_t h = 3 * t; h != 3 * t + 3; ++h) {
+        const Point2D a = mesh.Vertex(mesh.Origin(h));
+        const Point2D b = mesh.Vertex(mesh.Target(h));
+        if ((b - a).Cross(p - a) < -1e-9) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(point_location_test, square) {
+    std::vector<Point2D> points = {{0., 0.}, {100., 0.}, {100., 100.}, {0., 100.}};
+    const auto mesh = DelaunayTriangulationMesh(points).value();
+    const PointLocator locator{mesh};
+
+    const uint32_t t = locator.Locate({10., 10.});
+    ASSERT_NE(kNoIndex, t);
+    EXPECT_TRUE(Contains(mesh, t, {10., 10.}));
+    EXPECT_EQ(kNoIndex, locator.Locate({150., 50.}));
+    EXPECT_EQ(kNoIndex, locator.Locate({-1., -1.}, t));
+}
+
+TEST(point_location_test, batch_matches_containment) {
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{0., 1000.};
+    std::vector<Point2D> points(2000);
+    for (auto &p : points) {
+        p = {dist(gen), dist(gen)};
+    }
+    const auto mesh = DelaunayTriangulationMesh(points).value();
+    const PointLocator locator{mesh};
+    EXPECT_EQ(13u, locator.LandmarksCount());
+
+    std::uniform_real_distribution<double> query_dist{-100., 1100.};
+    std::vector<Point2D> queries(2000);
+    for (auto &q : queries) {
+        q = {query_dist(gen), query_dist(gen)};
+    }
+
+    const auto found = locator.Locate(queries);
+    ASSERT_EQ(queries.size(), found.size());
+    for (size_t i = 0; i != queries.size(); ++i) {
+        EXPECT_EQ(found[i] == kNoIndex, locator.Locate(queries[i]) == kNoIndex);
+        if (found[i] != kNoIndex) {
+            EXPECT_TRUE(Contains(mesh, found[i], queries[i]));
+        } else {
+            // вне триангуляции -- ни один треугольник не содержит точку
+            bool inside = false;
+            for (uint32_t t = 0; t != mesh.TrianglesCount() && !inside; ++t) {
+                inside = Contains(mesh, t, queries[i]);
+            }
+            EXPECT_FALSE(inside);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include "polygon_soa.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+
+TEST(polygon_soa_test, metrics) {
+    // L-образный многоугольник из 6 вершин: дополнение до kLanes не должно влиять на результат
+    const std::vector<Point2D> points = {{0., 0.}, {4., 0.}, {4., 2.}, {2., 2.}, {2., 4.}, {0., 4.}};
+    const PolygonSoA polygon{points};
+
+    EXPECT_EQ(points.size(), polygon.Size());
+    EXPECT_EQ((BoundingBox{0., 0., 4., 4.}), polygon.BoundBox());
+
+    const auto metrics = polygon.Metrics();
+    EXPECT_DOUBLE_EQ(12., metrics.signed_area);
+    EXPECT_DOUBLE_EQ(16., metrics.perimeter);
+    EXPECT_EQ(Winding::CounterClockwise, metrics.winding);
+    // центр масс: квадрат 4x2 с центром (2, 1) и квадрат 2x2 с центром (1, 3)
+    EXPECT_NEAR(5. / 3., metrics.centroid.x, 1e-12);
+    EXPECT_NEAR(5. / 3., metrics.centroid.y, 1e-12);
+
+    const std::vector<Point2D> reversed(points.rbegin(), points.rend());
+    const auto cw = PolygonSoA{reversed}.Metrics();
+    EXPECT_DOUBLE_EQ(-12., cw.signed_area);
+    EXPECT_EQ(Winding::Clockwise, cw.winding);
+
+    // все вершины на одной прямой
+    const std::vector<Point2D> line = {{0., 0.}, {1., 1.}, {2., 2.}};
+    const auto degenerate = PolygonSoA{line}.Metrics();
+    EXPECT_EQ(Winding::Degenerate, degenerate.winding);
+    EXPECT_NEAR(1., degenerate.centroid.x, 1e-12);
+
+    // почти на одной прямой: площадь на уровне ошибок округления, центр масс не улетает
+    const std::vector<Point2D> near_line = {{1e3, 1e3}, {1e3 + 1., 1e3 + 1. + 1e-13}, {1e3 + 2., 1e3 + 2.}};
+    const auto near_degenerate = PolygonSoA{near_line}.Metrics();
+    EXPECT_EQ(Winding::Degenerate, near_degenerate.winding);
+    EXPECT_NEAR(1e3 + 1., near_degenerate.centroid.x, 1e-9);
+    EXPECT_NEAR(1e3 + 1., near_degenerate.centroid.y, 1e-9);
+
+    EXPECT_EQ(Polygon{points}, polygon.ToPolygon());
+}
+
+TEST(polygon_soa_test, batch) {
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> dist(-1000., 1000.);
+
+    std::vector<PolygonSoA> polygons;
+    for (size_t n = 3; n != 40; ++n) {
+        std::vector<Point2D> points(n);
+        for (auto &p : points) {
+            p = {dist(gen), dist(gen)};
+        }
+        polygons.emplace_back(points);
+    }
+
+    const auto metrics = Metrics(polygons);
+    ASSERT_EQ(polygons.size(), metrics.size());
+    for (size_t i = 0; i != polygons.size(); ++i) {
+        // площадь по формуле шнурования в исходном виде
+        double area = 0;
+        const size_t n = polygons[i].Size();
+        for (size_t j = 0; j != n; ++j) {
+            const Point2D a = polygons[i].Vertex(j);
+            const Point2D b = polygons[i].Vertex((j + 1) % n);
+            area += a.Cross(b);
+        }
+        EXPECT_NEAR(area / 2, metrics[i].signed_area, 1e-6);
+    }
+}
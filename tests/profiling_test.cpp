@@ -0,0 +1,102 @@
+#include "memory_tracking.hpp"
+#include "profiling.hpp"
+#include <gtest/gtest.h>
+#include <format>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace geometry;
+using namespace geometry::profiling;
+
+TEST(profiling_test, scoped_timer_and_counters) {
+    Reset();
+
+    {
+        ScopedTimer timer{"profiling_test::scope"};
+        AddCount(Counter::CandidatePairs, 5);
+    }
+    std::jthread{[] { AddCount(Counter::CandidatePairs, 7); }}.join();
+
+    {
+        auto actual = 12u;
+        auto expected = TotalCount(Counter::CandidatePairs);
+        EXPECT_EQ(actual, expected);
+    }
+
+    {
+        std::ostringstream out;
+        WriteChromeTrace(out);
+        EXPECT_NE(out.str().find("\"name\":\"profiling_test::scope\",\"ph\":\"X\""), std::string::npos);
+        EXPECT_NE(out.str().find("\"candidate pairs\":12"), std::string::npos);
+    }
+
+    {
+        std::ostringstream out;
+        PrintSummary(out);
+        EXPECT_NE(out.str().find("profiling_test::scope"), std::string::npos);
+    }
+}
+
+TEST(profiling_test, ring_buffer_overwrites_oldest) {
+    ThreadBuffer buffer{0};
+    const uint32_t scope = RegisterScope("event");
+    for (uint64_t i = 0; i != ThreadBuffer::kCapacity + 10; ++i) {
+        buffer.Record({"event", i, 1}, scope);
+    }
+
+    const auto events = buffer.Events();
+    EXPECT_EQ(ThreadBuffer::kCapacity, events.size());
+    EXPECT_EQ(10u, events.front().start_ns);
+    EXPECT_EQ(ThreadBuffer::kCapacity + 9, events.back().start_ns);
+}
+
+TEST(profiling_test, summary_survives_ring_buffer_overflow) {
+    Reset();
+    const char *name = "profiling_test::overflow";
+    const uint64_t calls = ThreadBuffer::kCapacity + 10;
+    // одинаковые имена по разным адресам получают один слот
+    const uint32_t scope = RegisterScope(name);
+    EXPECT_EQ(scope, RegisterScope(std::string{name}.c_str()));
+    for (uint64_t i = 0; i != calls; ++i) {
+        CurrentThreadBuffer().Record({name, i, i == 5 ? 7'000u : 1'000u}, scope);
+    }
+
+    const auto &stats = CurrentThreadBuffer().Scopes()[scope];
+    EXPECT_EQ(calls, stats.calls);
+    EXPECT_EQ(calls * 1'000 + 6'000, stats.total_ns);
+    EXPECT_EQ(7'000u, stats.max_ns);
+
+    std::ostringstream out;
+    PrintSummary(out);
+    EXPECT_NE(out.str().find(std::format("{:<40} {:>10}", name, calls)), std::string::npos);
+    Reset();
+}
+
+TEST(profiling_test, scope_exit_does_not_allocate) {
+    if (!memory::GlobalHooksInstalled()) {
+        GTEST_SKIP() << "global operator new/delete hooks are not linked";
+    }
+    const uint32_t scope = RegisterScope("profiling_test::no_allocations");
+    CurrentThreadBuffer();
+
+    memory::ScopedAllocationCounter counter;
+    for (int i = 0; i != 100; ++i) {
+        ScopedTimer timer{"profiling_test::no_allocations", scope};
+    }
+    EXPECT_EQ(0u, counter.Allocations());
+    EXPECT_EQ(100u, CurrentThreadBuffer().Scopes()[scope].calls);
+    Reset();
+}
+
+TEST(profiling_test, macros_compile_in_any_mode) {
+    Reset();
+    {
+        GEOMETRY_PROFILE_SCOPE("profiling_test::macro");
+        GEOMETRY_PROFILE_COUNT(TrianglesVisited, 3);
+    }
+
+    auto actual = kEnabled ? 3u : 0u;
+    auto expected = TotalCount(Counter::TrianglesVisited);
+    EXPECT_EQ(actual, expected);
+}
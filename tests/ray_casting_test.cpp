@@ -0,0 +1,192 @@
+#include "queries.hpp"
+#include "ray_casting.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::intersections;
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// первое пересечение луча с границей фигуры перебором рёбер; kInfinity -- промах
+double BruteHit(const Ray &ray, const Shape &shape) {
+    if (const auto *circle = std::get_if<Circle>(&shape)) {
+        const Point2D f = ray.origin - circle->center_p;
+        const double a = ray.direction.Dot(ray.direction);
+        const double b = f.Dot(ray.direction);
+        const double discriminant = b * b - a * (f.Dot(f) - circle->radius * circle->radius);
+        if (discriminant < 0) {
+            return kInfinity;
+        }
+        for (const double t : {(-b - std::sqrt(discriminant)) / a, (-b + std::sqrt(discriminant)) / a}) {
+            if (t >= 0 && t <= ray.max_t) {
+                return t;
+            }
+        }
+        return kInfinity;
+    }
+
+    std::vector<Line> edges;
+    if (const auto *line = std::get_if<Line>(&shape)) {
+        edges.push_back(*line);
+    } else if (const auto *polygon = std::get_if<Polygon>(&shape)) {
+        edges = polygon->Edges();
+    } else {
+        const auto vertices = std::visit(
+            [](const auto &s) {
+                const auto points = s.Vertices();
+                return std::vector<Point2D>(points.begin(), points.end());
+            },
+            shape);
+        edges = Polygon{vertices}.Edges();
+    }
+
+    double res = kInfinity;
+    for (const Line &edge : edges) {
+        const Point2D e = edge.Direction();
+        const Point2D w = edge.start - ray.origin;
+        const double det = ray.direction.Cross(e);
+        if (det == 0) {
+            continue;
+        }
+        const double t = w.Cross(e) / det;
+        const double s = w.Cross(ray.direction) / det;
+        if (s >= 0 && s <= 1 && t >= 0 && t <= ray.max_t) {
+            res = std::min(res, t);
+        }
+    }
+    return res;
+}
+
+std::vector<Shape> RandomScene(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coord(-100., 100.);
+    std::uniform_real_distribution<double> size(0.5, 8.);
+    std::vector<Shape> shapes;
+    for (size_t i = 0; i != count; ++i) {
+        const Point2D c{coord(gen), coord(gen)};
+        const double s = size(gen);
+        switch (i % 6) {
+        case 0:
+            shapes.emplace_back(Line{c, {c.x + s, c.y - s}});
+            break;
+        case 1:
+            shapes.emplace_back(Triangle{c, {c.x + s, c.y}, {c.x, c.y + s}});
+            break;
+        case 2:
+            shapes.emplace_back(Rectangle{c, s, s / 2});
+            break;
+        case 3:
+            shapes.emplace_back(RegularPolygon{c, s, 3 + static_cast<int>(i % 7)});
+            break;
+        case 4:
+            shapes.emplace_back(Circle{c, s});
+            break;
+        default:
+            shapes.emplace_back(Polygon{{c, {c.x + s, c.y + s}, {c.x, c.y + 2 * s}, {c.x + s / 4, c.y + s}}});
+            break;
+        }
+    }
+    return shapes;
+}
+
+std::vector<Ray> RandomRays(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coord(-120., 120.);
+    std::uniform_real_distribution<double> angle(0., 2 * std::numbers::pi);
+    std::vector<Ray> rays;
+    for (size_t i = 0; i != count; ++i) {
+        const double a = angle(gen);
+        // часть лучей -- отрезки и лучи вдоль осей
+        Point2D direction{std::cos(a), std::sin(a)};
+        if (i % 5 == 0) {
+            direction = i % 2 == 0 ? Point2D{1., 0.} : Point2D{0., -1.};
+        }
+        rays.push_back({{coord(gen), coord(gen)}, direction, i % 3 == 0 ? 40. : kInfinity});
+    }
+    return rays;
+}
+
+}  // namespace
+
+TEST(ray_casting_test, first_hit) {
+    const std::vector<Shape> shapes = {Circle{{10., 0.}, 2.}, Rectangle{{3., -1.}, 2., 2.},
+                                       Line{{20., -5.}, {20., 5.}}};
+    const RayCaster caster{shapes};
+
+    const auto hit = caster.FirstHit({{0., 0.}, {1., 0.}});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(1u, hit->shape);
+    EXPECT_DOUBLE_EQ(3., hit->t);
+    EXPECT_EQ(Point2D(3., 0.), hit->point);
+
+    // изнутри окружности -- выход через границу
+    const auto inside = caster.FirstHit({{10., 0.}, {0., 2.}});
+    ASSERT_TRUE(inside.has_value());
+    EXPECT_EQ(0u, inside->shape);
+    EXPECT_DOUBLE_EQ(1., inside->t);
+
+    // отрезок кончается до прямоугольника, луч в обратную сторону ничего не задевает
+    EXPECT_FALSE(caster.FirstHit(Ray::FromSegment(Line{{0., 0.}, {2.5, 0.}})).has_value());
+    EXPECT_FALSE(caster.FirstHit({{0., 0.}, {-1., 0.}}).has_value());
+    EXPECT_FALSE(RayCaster{std::vector<Shape>{}}.FirstHit({{0., 0.}, {1., 0.}}).has_value());
+
+    const auto all = caster.AllHits({{0., 0.}, {1., 0.}});
+    ASSERT_EQ(3u, all.size());
+    EXPECT_EQ(1u, all[0].shape);
+    EXPECT_EQ(0u, all[1].shape);
+    EXPECT_DOUBLE_EQ(8., all[1].t);
+    EXPECT_EQ(2u, all[2].shape);
+}
+
+TEST(ray_casting_test, matches_brute_force) {
+    const auto shapes = RandomScene(600, 20);
+    auto rays = RandomRays(1001, 21);
+    // лучи вдоль верхней и правой граней охватывающих прямоугольников многоугольных фигур
+    for (const auto &shape : shapes) {
+        if (std::holds_alternative<Circle>(shape)) {
+            continue;
+        }
+        const auto box = queries::GetBoundBox(shape);
+        rays.push_back({{box.min_x - 5., box.max_y}, {1., 0.}});
+        rays.push_back({{box.max_x, box.max_y + 5.}, {0., -1.}});
+    }
+    const RayCaster caster{shapes};
+    const auto packets = caster.FirstHits(rays);
+    ASSERT_EQ(rays.size(), packets.size());
+
+    size_t hits = 0;
+    for (size_t i = 0; i != rays.size(); ++i) {
+        double expected = kInfinity;
+        size_t crossed = 0;
+        for (const auto &shape : shapes) {
+            const double t = BruteHit(rays[i], shape);
+            expected = std::min(expected, t);
+            crossed += t != kInfinity ? 1 : 0;
+        }
+
+        const auto hit = caster.FirstHit(rays[i]);
+        ASSERT_EQ(expected != kInfinity, hit.has_value()) << i;
+        ASSERT_EQ(hit.has_value(), packets[i].has_value()) << i;
+        if (hit) {
+            ++hits;
+            EXPECT_NEAR(expected, hit->t, 1e-9) << i;
+            EXPECT_NEAR(expected, packets[i]->t, 1e-9) << i;
+            EXPECT_NEAR(expected, BruteHit(rays[i], shapes[hit->shape]), 1e-9) << i;
+        }
+
+        const auto all = caster.AllHits(rays[i]);
+        EXPECT_EQ(crossed, all.size()) << i;
+        EXPECT_TRUE(std::ranges::is_sorted(all, {}, &RayHit::t));
+        for (const auto &h : all) {
+            EXPECT_NEAR(BruteHit(rays[i], shapes[h.shape]), h.t, 1e-9);
+        }
+    }
+    EXPECT_GT(hits, rays.size() / 4);
+}
@@ -0,0 +1,151 @@
+#include "convex_hull.hpp"
+#include "rotating_calipers.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::convex_hull;
+
+namespace {
+
+// перебор за O(h^2): наименьшие площадь, периметр и ширина по прямоугольникам, прижатым к рёбрам
+struct BruteForce {
+    double area = std::numeric_limits<double>::infinity();
+    double perimeter = std::numeric_limits<double>::infinity();
+    double width = std::numeric_limits<double>::infinity();
+    double diameter = 0;
+
+    explicit BruteForce(std::span<const Point2D> hull) {
+        for (size_t i = 0; i != hull.size(); ++i) {
+            const Point2D u = (hull[(i + 1) % hull.size()] - hull[i]).Normalize();
+            const Point2D n{-u.y, u.x};
+            double min_u = 0, max_u = 0, min_n = 0, max_n = 0;
+            for (const Point2D p : hull) {
+                min_u = std::min(min_u, (p - hull[i]).Dot(u));
+                max_u = std::max(max_u, (p - hull[i]).Dot(u));
+                min_n = std::min(min_n, (p - hull[i]).Dot(n));
+                max_n = std::max(max_n, (p - hull[i]).Dot(n));
+                diameter = std::max(diameter, p.DistanceTo(hull[i]));
+            }
+            area = std::min(area, (max_u - min_u) * (max_n - min_n));
+            perimeter = std::min(perimeter, 2 * (max_u - min_u + max_n - min_n));
+            width = std::min(width, max_n - min_n);
+        }
+    }
+};
+
+}  // namespace
+
+TEST(rotating_calipers_test, rotated_rectangle) {
+    // прямоугольник 4 x 2, повёрнутый на 30 градусов, с точкой на стороне
+    const Point2D u{std::sqrt(3.) / 2, 0.5};
+    const Point2D n{-0.5, std::sqrt(3.) / 2};
+    const Point2D c{10., -5.};
+    const std::vector<Point2D> hull = {c - u * 2 - n, c + u * 2 - n, c + u * 2, c + u * 2 + n, c - u * 2 + n};
+
+    const auto box = MinAreaRectangle(hull);
+    ASSERT_TRUE(box.has_value());
+    EXPECT_NEAR(8., box->Area(), 1e-9);
+    EXPECT_EQ(c, box->center);
+    EXPECT_NEAR(2., Width(hull).value(), 1e-9);
+    EXPECT_NEAR(std::sqrt(20.), Diameter(hull).value(), 1e-9);
+    EXPECT_NEAR(12., MinPerimeterRectangle(hull)->Perimeter(), 1e-9);
+
+    // обход по часовой стрелке даёт те же ответы
+    const std::vector<Point2D> reversed(hull.rbegin(), hull.rend());
+    EXPECT_NEAR(8., MinAreaRectangle(reversed)->Area(), 1e-9);
+    EXPECT_NEAR(2., Width(reversed).value(), 1e-9);
+
+    EXPECT_TRUE(box->Overlaps(*box));
+    EXPECT_FALSE(box->Overlaps(OrientedBox{c + n * 3, u, 2., 0.5}));
+    EXPECT_TRUE(box->Overlaps(OrientedBox{c + n * 3, n, 2., 0.5}));
+}
+
+TEST(rotating_calipers_test, degenerate_hulls) {
+    EXPECT_EQ(GeometryError::InsufficientPoints, FarthestPair({}).error());
+    EXPECT_EQ(GeometryError::InsufficientPoints, MinAreaRectangle({}).error());
+
+    const std::vector<Point2D> point = {{1., 2.}, {1., 2.}};
+    EXPECT_EQ(0., Diameter(point).value());
+    EXPECT_EQ(0., MinAreaRectangle(point)->Area());
+    EXPECT_EQ(Point2D(1., 2.), MinAreaRectangle(point)->center);
+
+    const std::vector<Point2D> segment = {{0., 0.}, {3., 4.}};
+    EXPECT_EQ(5., Diameter(segment).value());
+    EXPECT_EQ(0., Width(segment).value());
+    const auto box = MinPerimeterRectangle(segment);
+    EXPECT_NEAR(2.5, box->half_length, 1e-12);
+    EXPECT_EQ(Point2D(1.5, 2.), box->center);
+}
+
+TEST(rotating_calipers_test, repeated_vertices) {
+    // повторы вершин, в том числе первой в конце обхода, не мешают опорным указателям
+    const std::vector<Point2D> square = {{0., 0.}, {4., 0.}, {4., 0.}, {4., 4.}, {0., 4.}, {0., 0.}};
+    EXPECT_NEAR(16., MinAreaRectangle(square)->Area(), 1e-9);
+    EXPECT_NEAR(4., Width(square).value(), 1e-9);
+    EXPECT_NEAR(std::sqrt(32.), Diameter(square).value(), 1e-9);
+    const std::vector<Point2D> reversed(square.rbegin(), square.rend());
+    EXPECT_NEAR(16., MinAreaRectangle(reversed)->Area(), 1e-9);
+    EXPECT_NEAR(4., Width(reversed).value(), 1e-9);
+
+    // правильный шестиугольник с описанной окружностью радиуса 3
+    std::vector<Point2D> hexagon;
+    for (int i = 0; i != 6; ++i) {
+        const double angle = std::numbers::pi / 3 * i;
+        hexagon.emplace_back(3 * std::cos(angle), 3 * std::sin(angle));
+        if (i == 2) {
+            hexagon.push_back(hexagon.back());
+        }
+    }
+    EXPECT_NEAR(6., Diameter(hexagon).value(), 1e-9);
+    EXPECT_NEAR(3 * std::sqrt(3.), Width(hexagon).value(), 1e-9);
+
+    // у случайных оболочек с удвоенными вершинами ответы те же, что без повторов
+    std::mt19937 gen(21);
+    std::normal_distribution<double> dist(0., 100.);
+    for (int attempt = 0; attempt != 20; ++attempt) {
+        std::vector<Point2D> points(50);
+        for (auto &p : points) {
+            p = {dist(gen), dist(gen)};
+        }
+        const auto hull = GrahamScan(points).value();
+        std::vector<Point2D> doubled;
+        for (const Point2D p : hull) {
+            doubled.insert(doubled.end(), 2, p);
+        }
+        EXPECT_EQ(MinAreaRectangle(hull)->Area(), MinAreaRectangle(doubled)->Area());
+        EXPECT_EQ(Width(hull).value(), Width(doubled).value());
+        EXPECT_EQ(Diameter(hull).value(), Diameter(doubled).value());
+    }
+}
+
+TEST(rotating_calipers_test, matches_brute_force) {
+    std::mt19937 gen(20);
+    std::normal_distribution<double> dist(0., 100.);
+    for (size_t size : {3, 4, 10, 100, 1000}) {
+        for (int attempt = 0; attempt != 20; ++attempt) {
+            std::vector<Point2D> points(size);
+            for (auto &p : points) {
+                p = {dist(gen), 0.2 * dist(gen)};
+            }
+            const auto hull = GrahamScan(points).value();
+            const BruteForce expected{hull};
+
+            const auto box = MinAreaRectangle(hull).value();
+            EXPECT_NEAR(expected.area, box.Area(), 1e-6 * expected.area);
+            EXPECT_NEAR(expected.perimeter, MinPerimeterRectangle(hull)->Perimeter(), 1e-9 * expected.perimeter);
+            EXPECT_NEAR(expected.width, Width(hull).value(), 1e-9 * expected.width);
+            EXPECT_NEAR(expected.diameter, Diameter(hull).value(), 1e-9 * expected.diameter);
+
+            // все точки внутри найденного прямоугольника
+            for (const Point2D p : points) {
+                EXPECT_LE(std::abs((p - box.center).Dot(box.axis)), box.half_length + 1e-9);
+                EXPECT_LE(std::abs((p - box.center).Dot(box.Normal())), box.half_width + 1e-9);
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include "convex_hull.hpp"
+#include "memory_tracking.hpp"
+#include "scratch_arena.hpp"
+#include "triangulation.hpp"
+#include <gtest/gtest.h>
+#include <ranges>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::memory;
+
+namespace {
+
+std::vector<Point2D> MakePoints(size_t count) {
+    std::vector<Point2D> points;
+    for (size_t i = 0; i != count; ++i) {
+        const auto t = static_cast<double>(i);
+        points.push_back({std::fmod(t * 37.0, 101.0), std::fmod(t * 53.0, 97.0) + t * 0.001});
+    }
+    return points;
+}
+
+}  // namespace
+
+TEST(scratch_arena_test, serves_from_own_buffer) {
+    CountingResource upstream;
+    ScratchArena arena{4096, &upstream};
+
+    {
+        ScratchArena::Scope scope{arena};
+        std::pmr::vector<int> v(100, scope.Resource());
+        EXPECT_EQ(0u, upstream.Stats().allocations);
+    }
+
+    // после Reset буфер переиспользуется, а при переполнении память берётся у upstream
+    std::pmr::vector<int> big(10'000, arena.Resource());
+    EXPECT_GT(upstream.Stats().allocations, 0u);
+    big = std::pmr::vector<int>{};
+    arena.Reset();
+    EXPECT_EQ(upstream.Stats().allocations, upstream.Stats().deallocations);
+}
+
+TEST(scratch_arena_test, algorithms_match_default_allocator) {
+    const auto points = MakePoints(200);
+    ScratchArena arena{1 << 20};
+
+    {
+        ScratchArena::Scope scope{arena};
+        auto expected = convex_hull::GrahamScan(points);
+        auto actual = convex_hull::GrahamScan(points, scope.Resource());
+        ASSERT_TRUE(actual.has_value());
+        EXPECT_TRUE(std::ranges::equal(*expected, *actual));
+    }
+
+    {
+        ScratchArena::Scope scope{arena};
+        auto expected = triangulation::DelaunayTriangulation(points);
+        auto actual = triangulation::DelaunayTriangulation(points, scope.Resource());
+        ASSERT_TRUE(actual.has_value());
+        EXPECT_TRUE(std::ranges::equal(*expected, *actual));
+    }
+
+    {
+        auto actual = triangulation::DelaunayTriangulation(std::span(points).first(2), arena.Resource());
+        EXPECT_FALSE(actual.has_value());
+    }
+}
+
+TEST(scratch_arena_test, no_global_allocations) {
+    if (!GlobalHooksInstalled()) {
+        GTEST_SKIP() << "global operator new/delete hooks are not linked";
+    }
+
+    const auto points = MakePoints(400);
+    ScratchArena arena{4 << 20};
+
+    ScopedAllocationCounter counter;
+    for (int i = 0; i != 3; ++i) {
+        ScratchArena::Scope scope{arena};
+        auto triangles = triangulation::DelaunayTriangulation(points, scope.Resource());
+        ASSERT_TRUE(triangles.has_value());
+    }
+    EXPECT_EQ(0u, counter.Allocations());
+}
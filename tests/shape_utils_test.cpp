@@ -60,4 +60,73 @@ TEST_F(shape_utils_test, find_highest) {
         auto expected = FindHighestShape(shapes);
         EXPECT_NE(actual, expected);
     }
-}
\ No newline at end of file
+}
+
+TEST(philox_test, known_answers) {
+    {
+        auto actual = Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+        auto expected = Philox4x32::Generate({0, 0, 0, 0}, {0, 0});
+        EXPECT_EQ(actual, expected);
+    }
+
+    {
+        auto actual = Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+        auto expected =
+            Philox4x32::Generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+        EXPECT_EQ(actual, expected);
+    }
+
+    {
+        auto actual = Philox4x32::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+        auto expected =
+            Philox4x32::Generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(counter_based_shape_generator_test, deterministic_and_order_independent) {
+    for (auto distribution : {ShapeDistribution::Uniform, ShapeDistribution::GaussianClusters, ShapeDistribution::Grid,
+                              ShapeDistribution::HeavyTailed, ShapeDistribution::Degenerate}) {
+        CounterBasedShapeGenerator generator{42, distribution};
+
+        // параллельная генерация совпадает с поэлементной, в том числе для окна со смещением
+        const auto shapes = generator.GenerateShapes(20'000);
+        const auto window = generator.GenerateShapes(100, 15'000);
+        for (size_t i = 0; i < shapes.size(); i += 997) {
+            EXPECT_EQ(generator.GenerateShape(i), shapes[i]);
+        }
+        for (size_t i = 0; i != window.size(); ++i) {
+            EXPECT_EQ(shapes[15'000 + i], window[i]);
+        }
+
+        CounterBasedShapeGenerator other_seed{43, distribution};
+        EXPECT_NE(other_seed.GenerateShapes(100), generator.GenerateShapes(100));
+    }
+}
+
+TEST(counter_based_shape_generator_test, distributions) {
+    {
+        CounterBasedShapeGenerator generator{7, ShapeDistribution::Grid};
+        for (const auto &shape : generator.GenerateShapes(1000)) {
+            const auto bb = queries::GetBoundBox(shape);
+            EXPECT_TRUE(are_equals(std::remainder(bb.min_x, 10.0), 0.0) ||
+                        std::holds_alternative<RegularPolygon>(shape) || std::holds_alternative<Circle>(shape));
+        }
+    }
+
+    {
+        CounterBasedShapeGenerator generator{7, ShapeDistribution::HeavyTailed};
+        const auto shapes = generator.GenerateShapes(10'000);
+        const auto large = std::ranges::count_if(shapes, [](const Shape &s) { return queries::GetHeight(s) > 40.0; });
+        EXPECT_GT(large, 0);
+        EXPECT_LT(large, 1000);
+    }
+
+    {
+        CounterBasedShapeGenerator generator{7, ShapeDistribution::Degenerate};
+        for (const auto &shape : generator.GenerateShapes(1000)) {
+            const auto bb = queries::GetBoundBox(shape);
+            EXPECT_TRUE(are_equals(bb.min_x, bb.min_y));
+        }
+    }
+}
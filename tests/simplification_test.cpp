@@ -0,0 +1,106 @@
+#include "convex_hull.hpp"
+#include "simplification.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::simplification;
+
+namespace {
+
+// зашумлённая окружность из count вершин
+std::vector<Point2D> NoisyRing(size_t count, double noise) {
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> dist(-noise, noise);
+    std::vector<Point2D> points;
+    for (size_t i = 0; i != count; ++i) {
+        const double angle = 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(count);
+        const double radius = 100. + dist(gen);
+        points.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    return points;
+}
+
+}  // namespace
+
+TEST(simplification_test, square) {
+    // лишние вершины на сторонах квадрата и небольшой шум
+    const std::vector<Point2D> points = {{0., 0.},    {50., 0.01}, {100., 0.},   {100., 50.},
+                                         {100., 100.}, {50., 100.}, {0., 100.},  {0.01, 50.}};
+    const std::vector<Point2D> square = {{0., 0.}, {100., 0.}, {100., 100.}, {0., 100.}};
+
+    EXPECT_EQ(square, DouglasPeucker(points, 0.1));
+    EXPECT_EQ(square, Visvalingam(points, 1.));
+    // вершины точно на сторонах удаляются при любой точности, зашумлённые -- только при большой
+    EXPECT_EQ(6u, DouglasPeucker(points, 0.001).size());
+
+    // у открытой ломаной сохраняются концы
+    const std::vector<Point2D> line = {{0., 0.}, {1., 0.001}, {2., 0.}, {3., 5.}};
+    EXPECT_EQ((std::vector<Point2D>{{0., 0.}, {2., 0.}, {3., 5.}}), DouglasPeucker(line, 0.01, false));
+    EXPECT_EQ((std::vector<Point2D>{{0., 0.}, {3., 5.}}), Visvalingam(line, 100., false));
+}
+
+TEST(simplification_test, hierarchy_matches_douglas_peucker) {
+    const auto points = NoisyRing(5000, 2.);
+    const DetailHierarchy hierarchy{points};
+
+    for (const double tolerance : {0., 0.5, 1., 2., 5., 20., 1000.}) {
+        const auto expected = DouglasPeucker(points, tolerance);
+        EXPECT_EQ(expected, hierarchy.Level(tolerance));
+        EXPECT_EQ(expected.size(), hierarchy.VerticesCount(tolerance));
+        EXPECT_GE(expected.size(), 3u);
+    }
+
+    EXPECT_LE(hierarchy.VerticesCount(hierarchy.ToleranceFor(100)), 100u);
+
+    // упрощённая выпуклая оболочка остаётся выпуклой
+    const auto hull = convex_hull::GrahamScan(points).value();
+    const auto simplified = DouglasPeucker(hull, 1.);
+    ASSERT_LT(simplified.size(), hull.size());
+    for (size_t i = 0; i != simplified.size(); ++i) {
+        const Point2D a = simplified[i];
+        const Point2D b = simplified[(i + 1) % simplified.size()];
+        const Point2D c = simplified[(i + 2) % simplified.size()];
+        EXPECT_GT((b - a).Cross(c - b), 0.);
+    }
+}
+
+TEST(simplification_test, hierarchy_keeps_anchors) {
+    // опорные вершины остаются при бесконечной точности и при запросе меньше трёх вершин
+    constexpr double kInfinity = std::numeric_limits<double>::infinity();
+    const auto points = NoisyRing(1000, 2.);
+    const DetailHierarchy ring{points};
+    EXPECT_EQ(3u, ring.VerticesCount(kInfinity));
+    EXPECT_EQ(DouglasPeucker(points, kInfinity), ring.Level(kInfinity));
+    for (const size_t max_vertices : {0u, 1u, 2u, 3u}) {
+        const double tolerance = ring.ToleranceFor(max_vertices);
+        EXPECT_TRUE(std::isfinite(tolerance));
+        EXPECT_EQ(3u, ring.Level(tolerance).size());
+    }
+
+    const DetailHierarchy line{points, false};
+    EXPECT_EQ((std::vector<Point2D>{points.front(), points.back()}), line.Level(kInfinity));
+    EXPECT_EQ(DouglasPeucker(points, kInfinity, false), line.Level(kInfinity));
+    EXPECT_EQ(2u, line.VerticesCount(line.ToleranceFor(0)));
+
+    // из трёх вершин все опорные
+    const std::vector<Point2D> triangle = {{0., 0.}, {1., 0.}, {0., 1.}};
+    EXPECT_EQ(triangle, DetailHierarchy{triangle}.Level(kInfinity));
+    EXPECT_EQ(0., DetailHierarchy{triangle}.ToleranceFor(1));
+}
+
+TEST(simplification_test, batch) {
+    const std::vector<Polygon> polygons(100, Polygon{NoisyRing(1000, 1.)});
+    const auto simplified = Simplify(polygons, 3.);
+
+    ASSERT_EQ(polygons.size(), simplified.size());
+    const auto expected = Simplify(polygons.front(), 3.);
+    for (const auto &polygon : simplified) {
+        EXPECT_EQ(expected, polygon);
+        EXPECT_LT(polygon.Points().size(), 100u);
+    }
+}
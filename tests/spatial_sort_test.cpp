@@ -0,0 +1,97 @@
+#include "spatial_sort.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::spatial;
+
+TEST(spatial_sort_test, curve_order) {
+    // обход квадрата 4x4 по кривой Гильберта (строки -- y) и квадрата 2x2 в Z-порядке
+    constexpr uint64_t hilbert[4][4] = {{0, 1, 14, 15}, {3, 2, 13, 12}, {4, 7, 8, 11}, {5, 6, 9, 10}};
+    for (uint32_t y = 0; y != 4; ++y) {
+        for (uint32_t x = 0; x != 4; ++x) {
+            EXPECT_EQ(hilbert[y][x], HilbertIndex(x, y));
+        }
+    }
+    EXPECT_EQ((uint64_t{1} << 2 * kHilbertBits) - 1, HilbertIndex((1u << kHilbertBits) - 1, 0));
+    EXPECT_EQ(1u, MortonIndex(1, 0));
+    EXPECT_EQ(2u, MortonIndex(0, 1));
+
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> dist(-1000., 1000.);
+    std::vector<Point2D> points(5000);
+    for (auto &p : points) {
+        p = {dist(gen), dist(gen)};
+    }
+
+    for (const auto curve : {Curve::Hilbert, Curve::Morton}) {
+        const auto order = CurveOrder(points, curve);
+        ASSERT_EQ(points.size(), order.size());
+
+        // поразрядная сортировка совпадает с сортировкой сравнением
+        auto keys = detail::CurveKeys(points, curve);
+        std::ranges::sort(keys);
+        for (size_t i = 0; i != order.size(); ++i) {
+            EXPECT_EQ(keys[i].second, order[i]);
+        }
+    }
+
+    const std::vector<Shape> shapes = {Circle{{10., 10.}, 1.}, Rectangle{{-10., -10.}, 2., 2.}, Circle{{0., 0.}, 1.}};
+    const auto order = CurveOrder(shapes);
+    EXPECT_EQ(1u, order.front());
+    EXPECT_EQ(3u, ApplyOrder<Shape>(shapes, order).size());
+}
+
+TEST(spatial_sort_test, hilbert_grid) {
+    // на решётке 2^k x 2^k в углу кривая -- биекция на [0, 4^k), соседние номера -- соседние клетки
+    for (uint32_t bits = 1; bits <= 6; ++bits) {
+        const uint32_t side = 1u << bits;
+        std::vector<std::pair<uint32_t, uint32_t>> cells(side * side, {side, side});
+        for (uint32_t x = 0; x != side; ++x) {
+            for (uint32_t y = 0; y != side; ++y) {
+                const uint64_t index = HilbertIndex(x, y);
+                ASSERT_LT(index, cells.size());
+                ASSERT_EQ(side, cells[index].first);
+                cells[index] = {x, y};
+            }
+        }
+        for (size_t i = 1; i != cells.size(); ++i) {
+            const auto [x0, y0] = cells[i - 1];
+            const auto [x1, y1] = cells[i];
+            EXPECT_EQ(1u, (x0 > x1 ? x0 - x1 : x1 - x0) + (y0 > y1 ? y0 - y1 : y1 - y0)) << bits << ' ' << i;
+        }
+    }
+}
+
+TEST(spatial_sort_test, brio) {
+    std::mt19937 gen(21);
+    std::uniform_real_distribution<double> dist(0., 1.);
+    std::vector<Point2D> points(1 << 14);
+    for (auto &p : points) {
+        p = {dist(gen), dist(gen)};
+    }
+
+    auto order = BrioOrder(points);
+    ASSERT_EQ(points.size(), order.size());
+
+    // последний раунд -- примерно половина точек, отсортированная по кривой
+    const auto keys = detail::CurveKeys(points, Curve::Hilbert);
+    size_t tail = 0;
+    uint64_t previous = ~uint64_t{0};
+    for (size_t i = order.size(); i-- > 0;) {
+        const uint64_t key = keys[order[i]].first;
+        if (key > previous) {
+            break;
+        }
+        previous = key;
+        ++tail;
+    }
+    EXPECT_GT(tail, points.size() * 2 / 5);
+    EXPECT_LT(tail, points.size() * 3 / 5);
+
+    std::ranges::sort(order);
+    for (uint32_t i = 0; i != order.size(); ++i) {
+        ASSERT_EQ(i, order[i]);
+    }
+}
@@ -1,5 +1,7 @@
 #include "triangulation.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <memory_resource>
 
 using namespace geometry;
 using namespace geometry::triangulation;
@@ -22,3 +24,24 @@ TEST(triangulation_test, delaunay_fail) {
     EXPECT_FALSE(expected.has_value());
     EXPECT_EQ(actual, expected.error());
 }
+
+TEST(triangulation_test, delaunay_float) {
+    std::vector<Point2Df> points = {{0.f, 0.f}, {100.f, 0.f}, {100.f, 100.f}, {0.f, 100.f}};
+
+    auto actual = std::vector<BasicDelaunayTriangle<float>>{{{0.f, 0.f}, {100.f, 0.f}, {0.f, 100.f}},
+                                                            {{100.f, 0.f}, {100.f, 100.f}, {0.f, 100.f}}};
+    auto expected = DelaunayTriangulation(points);
+    EXPECT_TRUE(expected.has_value());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(triangulation_test, delaunay_float_pmr) {
+    std::vector<Point2Df> points = {{0.f, 0.f}, {100.f, 0.f}, {100.f, 100.f}, {0.f, 100.f}};
+    std::pmr::monotonic_buffer_resource resource;
+
+    auto actual = DelaunayTriangulation(points);
+    auto expected = DelaunayTriangulation(points, &resource);
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_EQ(expected->get_allocator().resource(), &resource);
+    EXPECT_TRUE(std::ranges::equal(*actual, *expected));
+}
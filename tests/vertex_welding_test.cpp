@@ -0,0 +1,63 @@
+#include "vertex_welding.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::spatial;
+
+TEST(vertex_welding_test, weld) {
+    VertexWelder welder{1e-6};
+
+    const auto a = welder.Weld({1., 1.});
+    const auto b = welder.Weld({2., 1.});
+    EXPECT_NE(a, b);
+
+    // совпадение с точностью tolerance, в том числе через границу клетки решётки
+    EXPECT_EQ(a, welder.Weld({1. + 4e-7, 1. - 4e-7}));
+    EXPECT_EQ(b, welder.Weld({std::nextafter(2., 0.), 1.}));
+    EXPECT_EQ(VertexWelder::kNoVertex, welder.Find({1. + 2e-6, 1.}));
+    EXPECT_EQ(2u, welder.Size());
+
+    EXPECT_EQ(VertexWelder::EdgeKey(a, b), VertexWelder::EdgeKey(b, a));
+    EXPECT_NE(VertexWelder::EdgeKey(a, b), VertexWelder::EdgeKey(a, a));
+}
+
+TEST(vertex_welding_test, many_points) {
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> dist(-1000., 1000.);
+    std::vector<Point2D> points(20000);
+    for (auto &p : points) {
+        p = {dist(gen), dist(gen)};
+    }
+
+    // таблица растёт с нуля, каждая точка сваривается со своим сдвинутым повтором
+    VertexWelder welder{1e-9};
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        ASSERT_EQ(i, welder.Weld(points[i]));
+    }
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        ASSERT_EQ(i, welder.Weld({points[i].x + 5e-10, points[i].y - 5e-10}));
+    }
+    EXPECT_EQ(points.size(), welder.Size());
+}
+
+TEST(vertex_welding_test, large_coordinates) {
+    // клетка меньше шага double: совпадают только равные координаты, точки не сваливаются в одну клетку
+    VertexWelder welder{1e-10};
+    std::vector<Point2D> points;
+    for (int i = 0; i != 20000; ++i) {
+        points.push_back({1e12 + i * 0.5, -3e9 - i * 0.25});
+    }
+    points.push_back({1e300, -1e300});
+    points.push_back({-1e300, 1e300});
+
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        ASSERT_EQ(i, welder.Weld(points[i]));
+    }
+    for (uint32_t i = 0; i != points.size(); ++i) {
+        ASSERT_EQ(i, welder.Find(points[i]));
+        ASSERT_EQ(VertexWelder::kNoVertex, welder.Find({std::nextafter(points[i].x, 0.), points[i].y}));
+    }
+    EXPECT_EQ(points.size(), welder.Size());
+}
@@ -0,0 +1,86 @@
+#include "voronoi.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace geometry;
+using namespace geometry::voronoi;
+
+namespace {
+
+double Area(std::span<const Point2D> cell) {
+    double area = 0.;
+    for (size_t i = 0; i != cell.size(); ++i) {
+        area += cell[i].Cross(cell[(i + 1) % cell.size()]);
+    }
+    return area / 2;
+}
+
+bool Contains(std::span<const Point2D> cell, Point2D p) {
+    for (size_t i = 0; i != cell.size(); ++i) {
+        if ((cell[(i + 1) % cell.size()] - cell[i]).Cross(p - cell[i]) < -1e-7) {
+            return false;
+        }
+    }
+    return !cell.empty();
+}
+
+// ячейки покрывают прямоугольник и каждая точка лежит в ячейке ближайшего сайта
+void ExpectValidDiagram(std::span<const Point2D> sites, const BoundingBox &box) {
+    const auto diagram = FortuneVoronoi(sites, box);
+    ASSERT_TRUE(diagram.has_value());
+    ASSERT_EQ(sites.size(), diagram->CellsCount());
+
+    // повторы сайта делят одну ячейку
+    double total = 0.;
+    for (size_t i = 0; i != sites.size(); ++i) {
+        if (std::ranges::find(sites, sites[i]) - sites.begin() == static_cast<ptrdiff_t>(i)) {
+            total += Area(diagram->Cell(i));
+        }
+    }
+    EXPECT_NEAR(box.Width() * box.Height(), total, 1e-6 * box.Width() * box.Height());
+
+    std::mt19937 gen{7};
+    std::uniform_real_distribution<double> dx{box.min_x, box.max_x};
+    std::uniform_real_distribution<double> dy{box.min_y, box.max_y};
+    for (int i = 0; i != 500; ++i) {
+        const Point2D q{dx(gen), dy(gen)};
+        const auto nearest = std::ranges::min_element(sites, {}, [&q](const Point2D &s) { return s.DistanceTo(q); });
+        EXPECT_TRUE(Contains(diagram->Cell(nearest - sites.begin()), q));
+    }
+}
+
+}  // namespace
+
+TEST(voronoi_test, random_sites) {
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{0., 1000.};
+    std::vector<Point2D> sites(2000);
+    for (auto &p : sites) {
+        p = {dist(gen), dist(gen)};
+    }
+
+    ExpectValidDiagram(sites, {0., 0., 1000., 1000.});
+    ExpectValidDiagram(sites, {200., 300., 400., 350.});
+}
+
+TEST(voronoi_test, degenerate_sites) {
+    // решётка: четыре сайта на каждой окружности событий, первая строка горизонтальна
+    std::vector<Point2D> grid;
+    for (int i = 0; i != 10; ++i) {
+        for (int j = 0; j != 10; ++j) {
+            grid.push_back({static_cast<double>(i), static_cast<double>(j)});
+        }
+    }
+    ExpectValidDiagram(grid, {-1., -1., 10., 10.});
+
+    const std::vector<Point2D> collinear = {{0., 0.}, {1., 1.}, {2., 2.}, {3., 3.}, {1., 1.}};
+    ExpectValidDiagram(collinear, {-5., -5., 5., 5.});
+
+    const auto single = FortuneVoronoi(std::vector<Point2D>{{1., 1.}}, {0., 0., 2., 2.});
+    ASSERT_TRUE(single.has_value());
+    EXPECT_EQ(4u, single->Cell(0).size());
+
+    EXPECT_EQ(GeometryError::InsufficientPoints, FortuneVoronoi({}, {0., 0., 1., 1.}).error());
+}